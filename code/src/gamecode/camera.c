@@ -1,5 +1,7 @@
 #include "gamecode/camera.h"
 
+#define ALIGN_ADDRESS(addr, al) (((s32)addr + (al-1)) & ~(al-1))
+
 /*
 	MoveGameCamera	    77.48%*
 */
@@ -49,7 +51,204 @@ void BlendGameCamera(struct cammtx_s *cam,float time) {
     return;
 }
 
-//NGC MATCH
+#define RAILGRIDMAX 32
+
+// Fetch the four corners of a rail edge, swapped like BestRailPosition does on levels 6 and 0x22.
+static void RailEdgeQuad(struct rail_s* rail, s32 i, s32 swap, struct nuvec_s* v) {
+    struct nuvec_s* p[4];
+    s32 i2;
+    s32 j;
+
+    i2 = i + 1;
+    if ((i2 == rail->edges) && (rail->circuit != 0)) {
+        i2 = 0;
+    }
+    p[0] = (struct nuvec_s*)(rail->pLEFT->pts + (i * rail->pLEFT->ptsize));
+    p[1] = (struct nuvec_s*)(rail->pLEFT->pts + (i2 * rail->pLEFT->ptsize));
+    p[2] = (struct nuvec_s*)(rail->pRIGHT->pts + (i2 * rail->pRIGHT->ptsize));
+    p[3] = (struct nuvec_s*)(rail->pRIGHT->pts + (i * rail->pRIGHT->ptsize));
+    for (j = 0; j < 4; j++) {
+        if (swap != 0) {
+            v[j].x = -p[j]->y;
+            v[j].y = p[j]->x;
+            v[j].z = p[j]->z;
+        }
+        else {
+            v[j] = *p[j];
+        }
+    }
+    return;
+}
+
+// Same containment test and height distance as BestRailPosition.
+static s32 RailEdgeContains(struct rail_s* rail, s32 i, s32 swap, struct nuvec_s* v, float* d) {
+    struct nuvec_s q[4];
+
+    RailEdgeQuad(rail, i, swap, q);
+    if ((0.0f <= (v->x - q[0].x) * (q[1].z - q[0].z) + (v->z - q[0].z) * (q[0].x - q[1].x))
+        && (0.0f <= (v->x - q[1].x) * (q[2].z - q[1].z) + (v->z - q[1].z) * (q[1].x - q[2].x))
+        && (0.0f <= (v->x - q[2].x) * (q[3].z - q[2].z) + (v->z - q[2].z) * (q[2].x - q[3].x))
+        && (0.0f <= (v->x - q[3].x) * (q[0].z - q[3].z) + (v->z - q[3].z) * (q[3].x - q[0].x))) {
+        *d = NuFabs(((q[0].y + q[1].y + q[2].y + q[3].y) * 0.25f - v->y));
+        return 1;
+    }
+    return 0;
+}
+
+// Order in which BestRailPosition's outward search would reach edge i from start.
+static s32 RailSearchOrder(s32 i, s32 start) {
+    if (i > start) {
+        return (i - start) * 2 - 1;
+    }
+    return (start - i) * 2;
+}
+
+static void InitRailGrid(struct rail_s* rail, struct railgrid_s* grid, s32 swap) {
+    struct nuvec_s q[4];
+    float minx;
+    float minz;
+    float maxx;
+    float maxz;
+    u16* count;
+    s32 size;
+    s32 pass;
+    s32 total;
+    s32 x0;
+    s32 z0;
+    s32 x1;
+    s32 z1;
+    s32 x;
+    s32 z;
+    s32 i;
+    s32 j;
+
+    memset(grid, 0, sizeof(struct railgrid_s));
+    minx = minz = 1e30f;
+    maxx = maxz = -1e30f;
+    for (i = 0; i < rail->edges; i++) {
+        RailEdgeQuad(rail, i, swap, q);
+        for (j = 0; j < 4; j++) {
+            minx = (q[j].x < minx) ? q[j].x : minx;
+            maxx = (q[j].x > maxx) ? q[j].x : maxx;
+            minz = (q[j].z < minz) ? q[j].z : minz;
+            maxz = (q[j].z > maxz) ? q[j].z : maxz;
+        }
+    }
+    grid->cellsize = (((maxx - minx) > (maxz - minz)) ? (maxx - minx) : (maxz - minz)) / RAILGRIDMAX;
+    if (grid->cellsize < 1.0f) {
+        grid->cellsize = 1.0f;
+    }
+    grid->x = minx;
+    grid->z = minz;
+    grid->nx = (s16)((maxx - minx) / grid->cellsize) + 1;
+    grid->nz = (s16)((maxz - minz) / grid->cellsize) + 1;
+    grid->nx = (grid->nx > RAILGRIDMAX) ? RAILGRIDMAX : grid->nx;
+    grid->nz = (grid->nz > RAILGRIDMAX) ? RAILGRIDMAX : grid->nz;
+
+    // Count pass fills 'start', second pass drops the edges in.
+    superbuffer_ptr.intaddr = ALIGN_ADDRESS(superbuffer_ptr.voidptr, 0x10);
+    count = (u16*)superbuffer_ptr.voidptr;
+    size = (grid->nx * grid->nz + 1) * sizeof(u16);
+    if ((superbuffer_ptr.u8 + size) > superbuffer_end.u8) {
+        return;
+    }
+    memset(count, 0, size);
+    for (pass = 0, total = 0; pass < 2; pass++) {
+        for (i = 0; i < rail->edges; i++) {
+            RailEdgeQuad(rail, i, swap, q);
+            minx = maxx = q[0].x;
+            minz = maxz = q[0].z;
+            for (j = 1; j < 4; j++) {
+                minx = (q[j].x < minx) ? q[j].x : minx;
+                maxx = (q[j].x > maxx) ? q[j].x : maxx;
+                minz = (q[j].z < minz) ? q[j].z : minz;
+                maxz = (q[j].z > maxz) ? q[j].z : maxz;
+            }
+            x0 = (s32)((minx - grid->x) / grid->cellsize);
+            x1 = (s32)((maxx - grid->x) / grid->cellsize);
+            z0 = (s32)((minz - grid->z) / grid->cellsize);
+            z1 = (s32)((maxz - grid->z) / grid->cellsize);
+            x0 = (x0 >= grid->nx) ? grid->nx - 1 : x0;
+            z0 = (z0 >= grid->nz) ? grid->nz - 1 : z0;
+            x1 = (x1 >= grid->nx) ? grid->nx - 1 : x1;
+            z1 = (z1 >= grid->nz) ? grid->nz - 1 : z1;
+            for (z = z0; z <= z1; z++) {
+                for (x = x0; x <= x1; x++) {
+                    if (pass == 0) {
+                        count[z * grid->nx + x + 1]++;
+                    }
+                    else {
+                        grid->edge[count[z * grid->nx + x]++] = (s16)i;
+                    }
+                }
+            }
+        }
+        if (pass == 0) {
+            for (j = 0; j < grid->nx * grid->nz; j++) {
+                total += count[j + 1];
+                count[j + 1] = total;
+            }
+            if ((superbuffer_ptr.u8 + size + total * sizeof(s16)) > superbuffer_end.u8) {
+                return;
+            }
+            grid->edge = (s16*)(superbuffer_ptr.u8 + size);
+        }
+    }
+    // The fill pass advanced each offset to the start of the next cell, shift them back.
+    for (j = grid->nx * grid->nz; j > 0; j--) {
+        count[j] = count[j - 1];
+    }
+    count[0] = 0;
+    grid->start = count;
+    superbuffer_ptr.u8 += size + total * sizeof(s16);
+    superbuffer_ptr.intaddr = ALIGN_ADDRESS(superbuffer_ptr.voidptr, 0x10);
+    return;
+}
+
+// Find the edge BestRailPosition would settle on, using the neighbours of iALONG first and then the grid cell.
+// Returns -1 if no edge of the rail contains the point.
+static s32 RailGridEdge(struct rail_s* rail, struct railgrid_s* grid, s32 swap, struct nuvec_s* v, s32 iALONG, s32 start) {
+    float d;
+    float dbest;
+    s32 best;
+    s32 cell;
+    s32 x;
+    s32 z;
+    s32 i;
+    s32 j;
+
+    if (iALONG != -1) {
+        for (j = 0; j < 3; j++) {
+            i = (j == 0) ? iALONG : ((j == 1) ? iALONG + 1 : iALONG - 1);
+            if ((i >= 0) && (i < rail->edges) && (RailEdgeContains(rail, i, swap, v, &d) != 0)) {
+                return i;
+            }
+        }
+    }
+    x = (s32)floor((v->x - grid->x) / grid->cellsize);
+    z = (s32)floor((v->z - grid->z) / grid->cellsize);
+    if ((x < 0) || (z < 0)) {
+        return -1;
+    }
+    // InitRailGrid puts edges on the max boundary in the last cell, look there too
+    x = (x >= grid->nx) ? grid->nx - 1 : x;
+    z = (z >= grid->nz) ? grid->nz - 1 : z;
+    cell = z * grid->nx + x;
+    best = -1;
+    for (j = grid->start[cell]; j < grid->start[cell + 1]; j++) {
+        i = grid->edge[j];
+        if (RailEdgeContains(rail, i, swap, v, &d) != 0) {
+            if ((best == -1)
+                || ((iALONG == -1) && ((d < dbest) || ((d == dbest) && (RailSearchOrder(i, start) < RailSearchOrder(best, start)))))
+                || ((iALONG != -1) && (RailSearchOrder(i, start) < RailSearchOrder(best, start)))) {
+                best = i;
+                dbest = d;
+            }
+        }
+    }
+    return best;
+}
+
 void InitRails(void) {
     struct rail_s* rail;
     s32 i;
@@ -60,6 +259,7 @@ void InitRails(void) {
     nRAILS = 0;
     if (world_scene[0] != NULL) {
         rail = Rail;
+        memset(RailGrid,0,sizeof(RailGrid));
         for (i = 0; i < 8;  i++, rail++) {
             rail->in_distance = 25.0f;
             rail->out_distance = 25.0f;
@@ -118,6 +318,7 @@ void InitRails(void) {
                                             }
                                         }
                                     }
+                                    InitRailGrid(rail,&RailGrid[i],((Level == 6) || (Level == 0x22)));
                                     nRAILS++;
                                 }
                             }
@@ -130,7 +331,6 @@ void InitRails(void) {
     return;
 }
 
-//NGC MATCH
 float BestRailPosition(struct nuvec_s* pos, struct RPos_s* rpos, s32 iRAIL, s32 iALONG) {
     struct nuvec_s v;
     struct nuvec_s v0;
@@ -181,6 +381,16 @@ float BestRailPosition(struct nuvec_s* pos, struct RPos_s* rpos, s32 iRAIL, s32
     } else {
         iVar3 = iALONG;
     }
+    // With a grid the first edge tested is the one the search would have found, so stop there.
+    if (RailGrid[iRAIL].start != NULL) {
+        iVar1 = RailGridEdge(rail,&RailGrid[iRAIL],bVar2,&v,iALONG,iVar3);
+        if (iVar1 == -1) {
+            dbest = 0.0f;
+            goto Finish;
+        }
+        iVar3 = iVar1;
+        iALONG = iVar1;
+    }
     iVar8 = iVar3 + 1;
     iVar7 = iVar3 - 1;
     iVar4 = 0;
@@ -71,4 +71,18 @@ struct rail_s
 
 struct rail_s Rail[8];
 
+// Uniform XZ grid over the edges of a rail, built by InitRails so BestRailPosition doesn't have to walk the rail.
+struct railgrid_s
+{
+    float x; // Grid origin.
+    float z;
+    float cellsize;
+    short nx;
+    short nz;
+    u16* start; // nx * nz + 1 offsets into edge.
+    short* edge; // Edge indices overlapping each cell.
+};
+
+struct railgrid_s RailGrid[8];
+
 #endif // !CAMERA_H
@@ -1,8 +1,15 @@
-//NGC MATCH
 struct nugspline_s * NuSplineFindPartial(struct nugscn_s *scene,char *name,char *txt) {
   struct nugspline_s *spl;
   s32 i;
   
+  if (scene->splineix != NULL) {
+    i = NuNameIxFindPrefix(scene->splineix,name);
+    if (i == -1) {
+      return NULL;
+    }
+    strcpy(txt,scene->splines[i].name);
+    return &scene->splines[i];
+  }
   spl = scene->splines;
   for(i = 0; i < scene->numsplines; i++) {
       if (strncasecmp(name,spl->name,strlen(name)) == 0) {
@@ -1,3 +1,5 @@
+void CrateIndexDirty(void); // crate index, see BuildCrateIndex
+
 //NGC MATCH
 void ResetCrateType2(CrateCube *crt) {
   crt->type2 = crt->type1;
@@ -8,19 +10,18 @@ void ResetCrateType2(CrateCube *crt) {
   return;
 }
 
-//NGC MATCH
 struct crate_s * NextCrate(struct crate_s *a) {
-  return (struct crate_s *)NuLstGetNext(crates,(struct nulnkhdr_s *)a);
+  return (struct crate_s *)NuPoolGetNext(crates,a);
 }
 
-//NGC MATCH
 void InitCrates(void) {
   s32 iVar2;
   s32 iVar4;
   
-  crates = NuLstCreate(0x100,0x28);
+  crates = NuPoolCreate(0x100,0x28);
   CRATECOUNT = 0;
   CRATEGROUPCOUNT = 0;
+  CrateIndexDirty();
   if (crate_scene != NULL) {
     for(iVar2 = 0; iVar2 < 28; iVar2++) {
       NuSpecialFind(crate_scene,(struct nuhspecial_s* )&crate_list[iVar2].obj,crate_list[iVar2].name);
@@ -46,16 +47,14 @@ void InitCrates(void) {
   return;
 }
 
-//NGC MATCH
 void CloseCrates(void) {
   if (crates != NULL) {
-    NuLstDestroy(crates);
+    NuPoolDestroy(crates);
     crates = NULL;
   }
   return;
 }
 
-//NGC MATCH
 s32 ReadCrateData(void) {
   s32 handle;
   s32 i;
@@ -120,6 +119,7 @@ s32 ReadCrateData(void) {
             }
       }
       NuFileClose(handle);
+      CrateIndexDirty();
       return 1;        
     }
   }
@@ -374,7 +374,407 @@ s32 CrateBelow(struct obj_s *obj,CrateCubeGroup *group,CrateCube *crate) {
   return 0;
 }
 
-//NGC MATCH
+// Crate index, built lazily the first time it is needed after a level load or crate reset.
+// Groups sit in a BVH over their XZ clip boxes. Crates inside a group are grid aligned (dx, dz in half units), so each group
+// also gets a column grid, and crates are kept in rail order for WipeCrates. CrateOff keeps the live counts up to date.
+#define CRATEIDXMAXGROUPS 256
+#define CRATEIDXMAXCRATES 1024
+#define CRATEIDXMAXCOLS 4096
+
+struct cratenode_s
+{
+    float minx;
+    float minz;
+    float maxx;
+    float maxz;
+    short left;
+    short right;
+    short group; // -1 for inner nodes.
+    short pad;
+};
+
+struct crategrid_s
+{
+    short dx; // Lowest column.
+    short dz;
+    short nx;
+    short nz;
+    short icol; // First column in CrateColStart.
+    short live; // Crates still on.
+};
+
+static struct cratenode_s CrateNode[CRATEIDXMAXGROUPS * 2];
+static struct crategrid_s CrateGrid[CRATEIDXMAXGROUPS];
+static u16 CrateColStart[CRATEIDXMAXCOLS + 1];
+static u16 CrateColLive[CRATEIDXMAXCOLS];
+static short CrateColList[CRATEIDXMAXCRATES];
+static u16 CrateColOf[CRATEIDXMAXCRATES];
+static u8 CrateGroupOf[CRATEIDXMAXCRATES];
+static short CrateRailOrder[CRATEIDXMAXCRATES];
+static s32 CrateRailCount;
+static s32 CrateNodeCount;
+static s32 CrateIndexState; // 0 needs building, 1 built, -1 too big to index.
+static u16 CrateStamp[CRATEIDXMAXCRATES];
+static u16 CrateStampId;
+
+void CrateIndexDirty(void) {
+    CrateIndexState = 0;
+    return;
+}
+
+static float CrateGroupCentre(s32 g, s32 axis) {
+    if (axis == 0) {
+        return (CrateGroup[g].minclip.x + CrateGroup[g].maxclip.x);
+    }
+    return (CrateGroup[g].minclip.z + CrateGroup[g].maxclip.z);
+}
+
+static s32 CrateBuildNode(short* groups, s32 n) {
+    struct cratenode_s* node;
+    short t;
+    s32 axis;
+    s32 i;
+    s32 j;
+    s32 ix;
+
+    ix = CrateNodeCount++;
+    node = &CrateNode[ix];
+    node->minx = node->minz = 1e30f;
+    node->maxx = node->maxz = -1e30f;
+    for (i = 0; i < n; i++) {
+        node->minx = (CrateGroup[groups[i]].minclip.x < node->minx) ? CrateGroup[groups[i]].minclip.x : node->minx;
+        node->minz = (CrateGroup[groups[i]].minclip.z < node->minz) ? CrateGroup[groups[i]].minclip.z : node->minz;
+        node->maxx = (CrateGroup[groups[i]].maxclip.x > node->maxx) ? CrateGroup[groups[i]].maxclip.x : node->maxx;
+        node->maxz = (CrateGroup[groups[i]].maxclip.z > node->maxz) ? CrateGroup[groups[i]].maxclip.z : node->maxz;
+    }
+    if (n == 1) {
+        node->group = groups[0];
+        node->left = node->right = -1;
+        return ix;
+    }
+    node->group = -1;
+    axis = ((node->maxx - node->minx) > (node->maxz - node->minz)) ? 0 : 1;
+    for (i = 1; i < n; i++) {
+        t = groups[i];
+        for (j = i; (j > 0) && (CrateGroupCentre(groups[j - 1], axis) > CrateGroupCentre(t, axis)); j--) {
+            groups[j] = groups[j - 1];
+        }
+        groups[j] = t;
+    }
+    node->left = CrateBuildNode(groups, n / 2);
+    node->right = CrateBuildNode(&groups[n / 2], n - n / 2);
+    return ix;
+}
+
+// Rail order used by FurtherALONG: rail type first, then rail, edge and distance along the edge.
+static s32 CrateRailCompare(CrateCube* a, CrateCube* b) {
+    if (Rail[a->iRAIL].type != Rail[b->iRAIL].type) {
+        return (Rail[a->iRAIL].type < Rail[b->iRAIL].type) ? -1 : 1;
+    }
+    if (a->iRAIL != b->iRAIL) {
+        return (a->iRAIL < b->iRAIL) ? -1 : 1;
+    }
+    if (a->iALONG != b->iALONG) {
+        return (a->iALONG < b->iALONG) ? -1 : 1;
+    }
+    if (a->fALONG != b->fALONG) {
+        return (a->fALONG < b->fALONG) ? -1 : 1;
+    }
+    return 0;
+}
+
+static void BuildCrateIndex(void) {
+    short groups[CRATEIDXMAXGROUPS];
+    u16 fill[CRATEIDXMAXCOLS];
+    struct crategrid_s* grid;
+    CrateCubeGroup* group;
+    CrateCube* crate;
+    s32 ncols;
+    s32 col;
+    s32 maxdx;
+    s32 maxdz;
+    s32 total;
+    s32 i;
+    s32 j;
+    short t;
+
+    CrateIndexState = -1;
+    if ((CRATEGROUPCOUNT > CRATEIDXMAXGROUPS) || (CRATECOUNT > CRATEIDXMAXCRATES)) {
+        return;
+    }
+
+    ncols = 0;
+    group = CrateGroup;
+    for (i = 0; i < CRATEGROUPCOUNT; i++, group++) {
+        grid = &CrateGrid[i];
+        grid->dx = grid->dz = 0x7fff;
+        maxdx = maxdz = -0x8000;
+        crate = &Crate[group->iCrate];
+        for (j = 0; j < group->nCrates; j++, crate++) {
+            grid->dx = (crate->dx < grid->dx) ? crate->dx : grid->dx;
+            grid->dz = (crate->dz < grid->dz) ? crate->dz : grid->dz;
+            maxdx = (crate->dx > maxdx) ? crate->dx : maxdx;
+            maxdz = (crate->dz > maxdz) ? crate->dz : maxdz;
+        }
+        if (group->nCrates == 0) {
+            grid->dx = grid->dz = 0;
+            maxdx = maxdz = -1;
+        }
+        grid->nx = maxdx - grid->dx + 1;
+        grid->nz = maxdz - grid->dz + 1;
+        grid->icol = ncols;
+        ncols += grid->nx * grid->nz;
+        if (ncols > CRATEIDXMAXCOLS) {
+            return;
+        }
+    }
+
+    // Count, prefix and fill the columns. Crates go in in index order so queries keep the original test order.
+    memset(CrateColStart, 0, sizeof(CrateColStart));
+    memset(CrateColLive, 0, sizeof(CrateColLive));
+    group = CrateGroup;
+    for (i = 0; i < CRATEGROUPCOUNT; i++, group++) {
+        grid = &CrateGrid[i];
+        grid->live = 0;
+        crate = &Crate[group->iCrate];
+        for (j = 0; j < group->nCrates; j++, crate++) {
+            col = grid->icol + (crate->dz - grid->dz) * grid->nx + (crate->dx - grid->dx);
+            CrateColOf[group->iCrate + j] = col;
+            CrateGroupOf[group->iCrate + j] = i;
+            CrateColStart[col + 1]++;
+            if (crate->on != 0) {
+                CrateColLive[col]++;
+                grid->live++;
+            }
+        }
+    }
+    for (col = 0, total = 0; col < ncols; col++) {
+        total += CrateColStart[col + 1];
+        CrateColStart[col + 1] = total;
+    }
+    memcpy(fill, CrateColStart, ncols * sizeof(u16));
+    for (i = 0; i < CRATECOUNT; i++) {
+        CrateColList[fill[CrateColOf[i]]++] = i;
+    }
+
+    CrateNodeCount = 0;
+    for (i = 0; i < CRATEGROUPCOUNT; i++) {
+        groups[i] = i;
+    }
+    if (CRATEGROUPCOUNT > 0) {
+        CrateBuildNode(groups, CRATEGROUPCOUNT);
+    }
+
+    CrateRailCount = 0;
+    for (i = 0; i < CRATECOUNT; i++) {
+        if (Crate[i].iRAIL == -1) {
+            continue;
+        }
+        t = i;
+        for (j = CrateRailCount; (j > 0) && (CrateRailCompare(&Crate[CrateRailOrder[j - 1]], &Crate[t]) > 0); j--) {
+            CrateRailOrder[j] = CrateRailOrder[j - 1];
+        }
+        CrateRailOrder[j] = t;
+        CrateRailCount++;
+    }
+    CrateIndexState = 1;
+    return;
+}
+
+// Called by CrateOff so empty columns and groups drop out of the ray casts.
+static void CrateIndexOff(CrateCube* crate) {
+    s32 i;
+
+    if (CrateIndexState != 1) {
+        return;
+    }
+    i = crate - Crate;
+    if (CrateColLive[CrateColOf[i]] != 0) {
+        CrateColLive[CrateColOf[i]]--;
+        CrateGrid[CrateGroupOf[i]].live--;
+    }
+    return;
+}
+
+static s32 CrateAddColumn(struct crategrid_s* grid, s32 x, s32 z, short* list, s32 n) {
+    s32 col;
+    s32 i;
+
+    x -= grid->dx;
+    z -= grid->dz;
+    if ((x < 0) || (x >= grid->nx) || (z < 0) || (z >= grid->nz)) {
+        return n;
+    }
+    col = grid->icol + z * grid->nx + x;
+    if (CrateColLive[col] == 0) {
+        return n;
+    }
+    for (i = CrateColStart[col]; i < CrateColStart[col + 1]; i++) {
+        if (CrateStamp[CrateColList[i]] != CrateStampId) {
+            CrateStamp[CrateColList[i]] = CrateStampId;
+            list[n++] = CrateColList[i];
+        }
+    }
+    return n;
+}
+
+// Gather the crates in the columns crossed by the group space segment v0 -> v1, once each and sorted by crate index.
+static s32 CrateGroupRayCandidates(struct crategrid_s* grid, struct nuvec_s* v0, struct nuvec_s* v1, short* list) {
+    float t0;
+    float t1;
+    float d[2];
+    float a[2];
+    float lo[2];
+    float hi[2];
+    float x;
+    float z;
+    float tmaxx;
+    float tmaxz;
+    float tdx;
+    float tdz;
+    s32 cx;
+    s32 cz;
+    s32 ex;
+    s32 ez;
+    s32 sx;
+    s32 sz;
+    s32 steps;
+    s32 n;
+    s32 i;
+    s32 j;
+    short t;
+
+    CrateStampId++;
+    if (CrateStampId == 0) {
+        memset(CrateStamp, 0, sizeof(CrateStamp));
+        CrateStampId = 1;
+    }
+
+    // Clip to the group's columns, working in column units (two per world unit).
+    a[0] = v0->x * 2.0f;
+    a[1] = v0->z * 2.0f;
+    d[0] = v1->x * 2.0f - a[0];
+    d[1] = v1->z * 2.0f - a[1];
+    lo[0] = grid->dx;
+    lo[1] = grid->dz;
+    hi[0] = grid->dx + grid->nx;
+    hi[1] = grid->dz + grid->nz;
+    t0 = 0.0f;
+    t1 = 1.0f;
+    for (i = 0; i < 2; i++) {
+        if (d[i] == 0.0f) {
+            if ((a[i] < lo[i]) || (a[i] > hi[i])) {
+                return 0;
+            }
+        }
+        else {
+            x = (lo[i] - a[i]) / d[i];
+            z = (hi[i] - a[i]) / d[i];
+            if (x > z) {
+                tmaxx = x;
+                x = z;
+                z = tmaxx;
+            }
+            t0 = (x > t0) ? x : t0;
+            t1 = (z < t1) ? z : t1;
+            if (t0 > t1) {
+                return 0;
+            }
+        }
+    }
+
+    x = a[0] + d[0] * t0;
+    z = a[1] + d[1] * t0;
+    cx = (s32)floor(x);
+    cz = (s32)floor(z);
+    ex = (s32)floor(a[0] + d[0] * t1);
+    ez = (s32)floor(a[1] + d[1] * t1);
+    steps = ((ex > cx) ? (ex - cx) : (cx - ex)) + ((ez > cz) ? (ez - cz) : (cz - ez)) + 1;
+    sx = (d[0] > 0.0f) ? 1 : -1;
+    sz = (d[1] > 0.0f) ? 1 : -1;
+    tdx = (d[0] != 0.0f) ? NuFabs(1.0f / d[0]) : 1e30f;
+    tdz = (d[1] != 0.0f) ? NuFabs(1.0f / d[1]) : 1e30f;
+    tmaxx = (d[0] != 0.0f) ? (((float)((sx > 0) ? (cx + 1) : cx) - a[0]) / d[0]) : 1e30f;
+    tmaxz = (d[1] != 0.0f) ? (((float)((sz > 0) ? (cz + 1) : cz) - a[1]) / d[1]) : 1e30f;
+
+    // Crate boxes are closed, so a segment starting on or running along a column edge touches the column behind it too.
+    n = 0;
+    if (x == (float)cx) {
+        n = CrateAddColumn(grid, cx - 1, cz, list, n);
+    }
+    if (z == (float)cz) {
+        n = CrateAddColumn(grid, cx, cz - 1, list, n);
+    }
+    for (; steps > 0; steps--) {
+        n = CrateAddColumn(grid, cx, cz, list, n);
+        if ((d[0] == 0.0f) && (x == (float)cx)) {
+            n = CrateAddColumn(grid, cx - 1, cz, list, n);
+        }
+        if ((d[1] == 0.0f) && (z == (float)cz)) {
+            n = CrateAddColumn(grid, cx, cz - 1, list, n);
+        }
+        if (tmaxx == tmaxz) {
+            n = CrateAddColumn(grid, cx + sx, cz, list, n);
+            n = CrateAddColumn(grid, cx, cz + sz, list, n);
+        }
+        if (tmaxx < tmaxz) {
+            tmaxx += tdx;
+            cx += sx;
+        }
+        else {
+            tmaxz += tdz;
+            cz += sz;
+        }
+    }
+
+    for (i = 1; i < n; i++) {
+        t = list[i];
+        for (j = i; (j > 0) && (list[j - 1] > t); j--) {
+            list[j] = list[j - 1];
+        }
+        list[j] = t;
+    }
+    return n;
+}
+
+// Groups whose XZ clip box overlaps the box vMIN -> vMAX and still have crates on, in group order.
+static s32 CrateGroupsInBox(struct nuvec_s* vMIN, struct nuvec_s* vMAX, short* list) {
+    short stack[64];
+    struct cratenode_s* node;
+    s32 sp;
+    s32 n;
+    s32 i;
+    s32 j;
+    short t;
+
+    n = 0;
+    sp = 0;
+    stack[sp++] = 0;
+    while (sp > 0) {
+        node = &CrateNode[stack[--sp]];
+        if ((vMAX->x < node->minx) || (vMIN->x > node->maxx) || (vMAX->z < node->minz) || (vMIN->z > node->maxz)) {
+            continue;
+        }
+        if (node->group != -1) {
+            if (CrateGrid[node->group].live != 0) {
+                list[n++] = node->group;
+            }
+        }
+        else {
+            stack[sp++] = node->right;
+            stack[sp++] = node->left;
+        }
+    }
+    for (i = 1; i < n; i++) {
+        t = list[i];
+        for (j = i; (j > 0) && (list[j - 1] > t); j--) {
+            list[j] = list[j - 1];
+        }
+        list[j] = t;
+    }
+    return n;
+}
+
 s32 CrateOff(CrateCubeGroup *group,CrateCube *crate,s32 kaboom,s32 chase) {
   struct nuvec_s pos;
   s32 type;
@@ -387,6 +787,7 @@ s32 CrateOff(CrateCubeGroup *group,CrateCube *crate,s32 kaboom,s32 chase) {
     return 0;
   }
   crate->on = 0;
+  CrateIndexOff(crate);
   if (crate->model != NULL) {
     crate->model->draw = 0;
   }
@@ -537,7 +938,6 @@ void ResetInvisibility(void) {
   return;
 }
 
-//NGC MATCH
 void ResetCrate(CrateCube *crt) {
   crt->mom = 0.0f;
   crt->oldy = crt->pos0.y;
@@ -553,6 +953,7 @@ void ResetCrate(CrateCube *crt) {
   crt->metal_count = 0;
   crt->action = -1;
   crt->appeared = 0;
+  CrateIndexDirty();
   return;
 }
 
@@ -831,13 +1232,72 @@ s32 HitCrates(struct obj_s *obj,s32 destroy) {
   }
 }
 
-//NGC MATCH
 s32 WipeCrates(s32 iRAIL0,s32 iALONG0,float fALONG0,s32 iRAIL1,s32 iALONG1,float fALONG1,s32 destroy) {
   CrateCubeGroup *group;
   CrateCube *crate;
+  CrateCube key;
+  short list[CRATEIDXMAXCRATES];
   s32 i;
   s32 j;
+  s32 n;
+  s32 lo;
+  s32 hi;
   s32 type;
+  short t;
+
+  if (CrateIndexState == 0) {
+    BuildCrateIndex();
+  }
+  if (CrateIndexState == 1) {
+      // Only crates strictly between the two rail positions can pass both FurtherALONG tests,
+      // so binary search the rail order for the first one and walk forward.
+      if ((iRAIL0 == -1) || (iRAIL1 == -1) || (Rail[iRAIL0].type != Rail[iRAIL1].type)) {
+          return 0;
+      }
+      key.iRAIL = iRAIL0;
+      key.iALONG = iALONG0;
+      key.fALONG = fALONG0;
+      lo = 0;
+      hi = CrateRailCount;
+      while (lo < hi) {
+          j = (lo + hi) >> 1;
+          if (CrateRailCompare(&Crate[CrateRailOrder[j]],&key) <= 0) {
+              lo = j + 1;
+          }
+          else {
+              hi = j;
+          }
+      }
+      for (n = 0; lo < CrateRailCount; lo++) {
+          crate = &Crate[CrateRailOrder[lo]];
+          if (FurtherALONG(iRAIL1,iALONG1,fALONG1,crate->iRAIL,crate->iALONG,crate->fALONG) == 0) {
+              break;
+          }
+          if (FurtherALONG(crate->iRAIL,crate->iALONG,crate->fALONG,iRAIL0,iALONG0,fALONG0) != 0) {
+              list[n++] = CrateRailOrder[lo];
+          }
+      }
+      // Break them in the same order as the full sweep.
+      for (i = 1; i < n; i++) {
+          t = list[i];
+          for (j = i; (j > 0) && (list[j - 1] > t); j--) {
+              list[j] = list[j - 1];
+          }
+          list[j] = t;
+      }
+      for (i = 0; i < n; i++) {
+          crate = &Crate[list[i]];
+          group = &CrateGroup[CrateGroupOf[list[i]]];
+          if (crate->on != 0) {
+              type = GetCrateType(crate,0);
+              if ((u32)(type + 1) > 1 &&
+                  ((destroy == 1) || ((destroy == 2 && (type != 7)) && (type != 0xe && (type != 0x11))))) {
+                  BreakCrate(group,crate,type,0x200);
+              }
+          }
+      }
+      return 0;
+  }
 
   group = CrateGroup;
   for(i = 0; i < CRATEGROUPCOUNT; i++, group++) {
@@ -992,7 +1452,6 @@ s32 RayIntersectCuboid(struct nuvec_s *p0,struct nuvec_s *p1,struct nuvec_s *min
   return 0;
 }
 
-//NGC MATCH
 s32 CrateRayCast(struct nuvec_s *p0,struct nuvec_s *p1) {
   struct nuvec_s vMIN;
   struct nuvec_s vMAX;
@@ -1007,12 +1466,55 @@ s32 CrateRayCast(struct nuvec_s *p0,struct nuvec_s *p1) {
   float ratio;
   CrateCubeGroup *group;
   CrateCube *crate;
+  short groups[CRATEIDXMAXGROUPS];
+  short list[CRATEIDXMAXCRATES];
+  s32 ngroups;
+  s32 n;
   
   ratio = 1.0f;
   vMIN.x = (p0->x < p1->x) ? p0->x : p1->x;
   vMIN.z = (p0->z < p1->z) ? p0->z : p1->z;
   vMAX.x = (p0->x > p1->x) ? p0->x : p1->x;
   vMAX.z = (p0->z > p1->z) ? p0->z : p1->z;
+  if (CrateIndexState == 0) {
+    BuildCrateIndex();
+  }
+  if (CrateIndexState == 1) {
+      ngroups = CrateGroupsInBox(&vMIN,&vMAX,groups);
+      for(i = 0; i < ngroups; i++) {
+          group = &CrateGroup[groups[i]];
+          v0.x = p0->x - (group->origin).x;
+          v0.y = p0->y;
+          v0.z = p0->z - (group->origin).z;
+          NuVecRotateY(&v0,&v0,-(uint)group->angle);
+          v1.x = p1->x - (group->origin).x;
+          v1.y = p1->y;
+          v1.z = p1->z - (group->origin).z;
+          NuVecRotateY(&v1,&v1,-(uint)group->angle);
+          n = CrateGroupRayCandidates(&CrateGrid[groups[i]],&v0,&v1,list);
+          for(j = 0; j < n; j++) {
+              crate = &Crate[list[j]];
+              if ((crate->on != 0) && (crate->in_range != 0)) {
+                  type = GetCrateType(crate,0) + 1;
+                  if ((u32)type > 1) {
+                      min.x = ((s32)crate->dx * 0.5f);
+                      min.y = crate->pos.y;
+                      min.z = (crate->dz * 0.5f);
+                      max.x = (min.x + 0.5f);
+                      max.y = min.y + 0.5f;
+                      max.z = (min.z + 0.5f);
+                      if ((RayIntersectCuboid(&v0,&v1,&min,&max) != 0) && (temp_ratio < ratio)) {
+                          face = temp_face;
+                          ratio = temp_ratio;
+                      }
+                  }
+              }
+          }
+      }
+      temp_face = face;
+      temp_ratio = ratio;
+      return (ratio < 1.0f) ? 1 : 0;
+  }
   group = CrateGroup;
   for(i = 0; i < CRATEGROUPCOUNT; i++, group++) {
       if ((((vMAX.x >= group->minclip.x) && (vMIN.x <= group->maxclip.x)) &&
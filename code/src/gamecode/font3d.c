@@ -184,11 +184,12 @@ void Reset3DFontObjects(void) {
   return;
 }
 
-//NGC MATCH
 void InitFont3D(struct nugscn_s* gscn) {
     struct numtl_s* mtl;
     int i;
 
+    // cached strings point at the old scene's materials
+    Font3DCacheFlush();
     for (i = 0; Font3DTab[i].ascii != 0; i++) {
         Font3DTab[i].obj.scene = NULL;
         Font3DTab[i].obj.special = NULL;
@@ -251,7 +252,536 @@ s32 CombinationCharacterBC(char c0,char c1) {
 }
 
 
-//93% NGC
+#define FONT3D_CACHESIZE 48
+#define FONT3D_CACHELEN 0x80
+#define FONT3D_CACHEICONS 8
+#define FONT3D_CACHEMTLS 8
+
+// Offsets below are in font3d_dx units across and font3d_dy units up, from the x, y passed to Text3D.
+
+// Size: 0x10
+struct font3dcacheicon_s {
+    s32 obj; // Font3DObjTab index
+    struct numtl_s** mtltab;
+    float ux;
+    float uy;
+};
+
+// Size: 0x134
+struct font3dcache_s {
+    char txt[FONT3D_CACHELEN];
+    u32 hash;
+    s32 align;
+    s32 colour;
+    float mulx;
+    float muly;
+    float xstart;
+    float xend;
+    float yoff;
+    struct nugobj_s* gobj; // every glyph, one geom per material
+    s32 failed; // drawn the old way
+    s32 nicons;
+    struct font3dcacheicon_s icon[FONT3D_CACHEICONS];
+    u32 used;
+    s32 scene; // NuRndrSceneCount it was last queued in
+};
+
+// Size: 0x18
+struct font3dglyph_s {
+    struct nugobj_s* gobj;
+    struct numtl_s** mtltab;
+    float ux;
+    float uy;
+    float zscale;
+    s32 rot;
+};
+
+static struct font3dcache_s font3d_cache[FONT3D_CACHESIZE];
+static struct font3dglyph_s font3d_glyph[FONT3D_CACHELEN * 2];
+static u32 font3d_cacheclock;
+
+static u32 Font3DCacheHash(char* txt) {
+    u32 h;
+
+    h = 0x811c9dc5;
+    for (; *txt != 0; txt++) {
+        h = (h ^ (u8)*txt) * 0x01000193;
+    }
+    return h;
+}
+
+// Also used on a half built gobj, so any buffer may be missing.
+static void Font3DCacheFreeGobj(struct font3dcache_s* e) {
+    struct nugeom_s* geom;
+    struct nugeom_s* next;
+
+    if (e->gobj != NULL) {
+        for (geom = e->gobj->geom; geom != NULL; geom = next) {
+            next = geom->next;
+            if (geom->prim != NULL) {
+                if (geom->prim->idxbuff != 0) {
+                    GS_DeleteBuffer((void*)geom->prim->idxbuff);
+                }
+                free(geom->prim);
+            }
+            if (geom->hVB != 0) {
+                GS_DeleteBuffer((void*)geom->hVB);
+            }
+            free(geom);
+        }
+        free(e->gobj);
+        e->gobj = NULL;
+    }
+}
+
+static void Font3DCacheFree(struct font3dcache_s* e) {
+    Font3DCacheFreeGobj(e);
+    e->txt[0] = 0;
+}
+
+void Font3DCacheFlush(void) {
+    s32 i;
+
+    for (i = 0; i < FONT3D_CACHESIZE; i++) {
+        Font3DCacheFree(&font3d_cache[i]);
+    }
+}
+
+static s32 Font3DCacheGlyph(s32 n, struct nuspecial_s* special, struct numtl_s** mtltab, float ux, float uy, float zscale, s32 rot) {
+    struct font3dglyph_s* g;
+
+    if ((special == NULL) || (font3d_scene->gobjs[special->instance->objid] == NULL)) {
+        return n;
+    }
+    g = &font3d_glyph[n];
+    g->gobj = font3d_scene->gobjs[special->instance->objid];
+    g->mtltab = mtltab;
+    g->ux = ux;
+    g->uy = uy;
+    g->zscale = zscale;
+    g->rot = rot;
+    return n + 1;
+}
+
+// Same placement as Text3D, but in units so the scale can be applied when drawing.
+static s32 Font3DCacheLayout(struct font3dcache_s* e) {
+    struct numtl_s** mtltab;
+    char* txt;
+    float u;
+    float uy;
+    float w;
+    float gx;
+    float gy;
+    float f;
+    s32 n;
+    s32 i;
+    s32 j;
+    s32 accent;
+    s32 rot;
+    char c;
+
+    txt = e->txt;
+    w = 0.0f;
+    for (j = 0; txt[j] != 0; j++) {
+        if (txt[j] == '#') {
+            if (txt[j + 1] != 0) {
+                j++;
+            }
+        } else {
+            w += ((txt[j] == ':') || (txt[j] == '.')) ? 0.5f : 1.0f;
+        }
+    }
+    switch (e->align & 0x14) {
+        case 0x10:
+            u = 0.5f - w;
+            break;
+        case 4:
+            u = 0.5f;
+            break;
+        default:
+            u = 0.5f - w * 0.5f;
+            break;
+    }
+    e->xstart = u;
+    if ((e->align & 10) == 8) {
+        uy = 0.5f;
+    } else if ((e->align & 10) == 2) {
+        uy = -0.5f;
+    } else {
+        uy = 0.0f;
+    }
+    e->yoff = uy;
+
+    mtltab = &Font3DMtlTab[0][e->colour * 2];
+    e->nicons = 0;
+    n = 0;
+    for (j = 0; txt[j] != 0; j++) {
+        c = txt[j];
+        if (c == '#') {
+            if (txt[j + 1] != 0) {
+                j++;
+                switch (txt[j]) {
+                    case 'o':
+                        i = 0;
+                        break;
+                    case 'w':
+                        i = 1;
+                        break;
+                    case 'c':
+                        i = 2;
+                        break;
+                    case 'b':
+                        i = 3;
+                        break;
+                    case 'g':
+                        i = 4;
+                        break;
+                    default:
+                        i = -1;
+                        break;
+                }
+                if (i != -1) {
+                    mtltab = &Font3DMtlTab[0][i * 2];
+                }
+            }
+            continue;
+        }
+        if ((c < 0) && (c != '\xF8') && (c != '\xFE')) {
+            accent = RemapAccentedCharacter(&c);
+            if (accent == -1) {
+                if (Font3DRemap[122] != -1) {
+                    n = Font3DCacheGlyph(n, Font3DTab[Font3DRemap[122]].obj.special, mtltab, u, uy, 4.0f, 0);
+                }
+            } else {
+                if (Font3DRemap[(u8)c] != -1) {
+                    n = Font3DCacheGlyph(n, Font3DTab[Font3DRemap[(u8)c]].obj.special, mtltab, u, uy, 4.0f, 0);
+                }
+                n = Font3DCacheGlyph(n, Font3DAccentTab[accent].obj.special, mtltab, u, uy, 6.0f, 0);
+            }
+        } else if ((c >= 'a') && (c <= 'z') && (Font3DRemap[(u8)c] == -1)) {
+            // icons can animate, they're still drawn one by one
+            if (e->nicons == FONT3D_CACHEICONS) {
+                return -1;
+            }
+            e->icon[e->nicons].obj = c - 'a';
+            e->icon[e->nicons].mtltab = mtltab;
+            e->icon[e->nicons].ux = u;
+            e->icon[e->nicons].uy = uy;
+            e->nicons++;
+        } else if (c != ' ') {
+            i = Font3DRemap[(u8)c];
+            if (i == -1) {
+                i = Font3DRemap[122];
+            }
+            if (i != -1) {
+                gx = u;
+                gy = uy;
+                if ((c == ':') || (c == '.')) {
+                    gx -= 0.25f;
+                }
+                if (c == '\xFE') {
+                    gx -= 0.2f;
+                    gy += 0.3f;
+                }
+                if ((c == 'x') || (c == 'y') || (c == 'a') || (c == 'b') || (c == 'w') || (c == 'n')) {
+                    f = 1.0f;
+                } else {
+                    f = 4.0f;
+                }
+                rot = 0;
+                if ((j == 0) && ((c == '?') || (c == '!'))) {
+                    rot = 0x8000;
+                }
+                n = Font3DCacheGlyph(n, Font3DTab[i].obj.special, mtltab, gx, gy, f, rot);
+            }
+        }
+        u += ((c == ':') || (c == '.')) ? 0.5f : 1.0f;
+    }
+    e->xend = u;
+    return n;
+}
+
+static struct numtl_s* Font3DCacheMtl(struct numtl_s** mtltab, struct nugeom_s* geom) {
+    if (geom->mtl->special_id != 0) {
+        return mtltab[geom->mtl->special_id];
+    }
+    return geom->mtl;
+}
+
+// Bake every glyph into one gobj at unit scale, returns 0 if any of them can't be merged.
+static s32 Font3DCacheBuild(struct font3dcache_s* e, s32 nglyphs) {
+    struct numtl_s* mtl[FONT3D_CACHEMTLS];
+    struct nugeom_s* dst[FONT3D_CACHEMTLS];
+    u16* out[FONT3D_CACHEMTLS];
+    s32 nvtx[FONT3D_CACHEMTLS];
+    s32 nidx[FONT3D_CACHEMTLS];
+    struct font3dglyph_s* g;
+    struct nugobj_s* gobj;
+    struct nugeom_s* geom;
+    struct nuprim_s* prim;
+    struct nuvtx_tc1_s* src;
+    struct nuvtx_tc1_s* vtx;
+    struct numtl_s* m;
+    struct numtx_s gm;
+    struct nuvec_s s;
+    struct nuvec_s p;
+    s32 nmtl;
+    s32 split;
+    s32 i;
+    s32 j;
+    s32 k;
+
+    nmtl = 0;
+    for (i = 0; i < nglyphs; i++) {
+        for (gobj = font3d_glyph[i].gobj; gobj != NULL; gobj = gobj->next_gobj) {
+            if ((gobj->type != NUGOBJ_MESH) || (gobj->faceon_geom != NULL)) {
+                return 0;
+            }
+            for (geom = gobj->geom; geom != NULL; geom = geom->next) {
+                m = Font3DCacheMtl(font3d_glyph[i].mtltab, geom);
+                if (m == NULL) {
+                    continue;
+                }
+                if ((geom->vtxtype != NUVT_TC1) || (geom->hVB == 0) || (geom->skin != NULL) || (geom->vtxskininfo != NULL)
+                    || (geom->blendgeom != NULL)) {
+                    return 0;
+                }
+                for (k = 0; (k < nmtl) && (mtl[k] != m); k++) {}
+                if (k == nmtl) {
+                    if (nmtl == FONT3D_CACHEMTLS) {
+                        return 0;
+                    }
+                    mtl[k] = m;
+                    nvtx[k] = 0;
+                    nidx[k] = 0;
+                    nmtl++;
+                }
+                nvtx[k] += geom->vtxcnt;
+                for (prim = geom->prim; prim != NULL; prim = prim->next) {
+                    j = NuPrimTriListSize(geom, prim);
+                    if (j < 0) {
+                        return 0;
+                    }
+                    nidx[k] += j;
+                }
+            }
+        }
+    }
+    for (k = 0; k < nmtl; k++) {
+        if ((nvtx[k] > 0xffff) || (nidx[k] > 0xffff)) {
+            return 0;
+        }
+    }
+    if (nmtl == 0) {
+        return 1;
+    }
+
+    e->gobj = (struct nugobj_s*)malloc(sizeof(struct nugobj_s));
+    if (e->gobj == NULL) {
+        return 0;
+    }
+    memset(e->gobj, 0, sizeof(struct nugobj_s));
+    e->gobj->culltype = 1;
+    for (k = 0; k < nmtl; k++) {
+        dst[k] = (struct nugeom_s*)malloc(sizeof(struct nugeom_s));
+        if (dst[k] == NULL) {
+            Font3DCacheFreeGobj(e);
+            return 0;
+        }
+        memset(dst[k], 0, sizeof(struct nugeom_s));
+        NuGobjAddGeom(e->gobj, dst[k]);
+        dst[k]->mtl = mtl[k];
+        dst[k]->vtxtype = NUVT_TC1;
+        dst[k]->hVB = (s32)GS_CreateBuffer(nvtx[k] * sizeof(struct nuvtx_tc1_s), 1);
+        dst[k]->prim = (struct nuprim_s*)malloc(sizeof(struct nuprim_s));
+        if ((dst[k]->hVB == 0) || (dst[k]->prim == NULL)) {
+            Font3DCacheFreeGobj(e);
+            return 0;
+        }
+        memset(dst[k]->prim, 0, sizeof(struct nuprim_s));
+        dst[k]->prim->type = NUPT_NDXTRI;
+        dst[k]->prim->idxbuff = (s32)GS_CreateBuffer(nidx[k] * 2, 2);
+        if (dst[k]->prim->idxbuff == 0) {
+            Font3DCacheFreeGobj(e);
+            return 0;
+        }
+        out[k] = (u16*)dst[k]->prim->idxbuff;
+    }
+
+    for (i = 0; i < nglyphs; i++) {
+        g = &font3d_glyph[i];
+        s.x = FONT3DSIZE;
+        s.y = FONT3DSIZE;
+        s.z = FONT3DSIZE * g->zscale;
+        NuMtxSetScale(&gm, &s);
+        if (g->rot != 0) {
+            NuMtxRotateZ(&gm, g->rot);
+        }
+        gm._30 = g->ux * 0.1f * PANEL3DMULX;
+        gm._31 = g->uy * 0.1f * FONT3DYMUL * PANEL3DMULY;
+        gm._32 = 0.0f;
+        // NuRndrGobj only offsets split objects by their origin
+        split = (g->gobj->next_gobj != NULL);
+        for (gobj = g->gobj; gobj != NULL; gobj = gobj->next_gobj) {
+            for (geom = gobj->geom; geom != NULL; geom = geom->next) {
+                m = Font3DCacheMtl(g->mtltab, geom);
+                if (m == NULL) {
+                    continue;
+                }
+                for (k = 0; mtl[k] != m; k++) {}
+                for (prim = geom->prim; prim != NULL; prim = prim->next) {
+                    out[k] = NuPrimTriList(out[k], geom, prim, dst[k]->vtxcnt);
+                }
+                src = (struct nuvtx_tc1_s*)geom->hVB;
+                vtx = (struct nuvtx_tc1_s*)dst[k]->hVB + dst[k]->vtxcnt;
+                for (j = 0; j < geom->vtxcnt; j++, src++, vtx++) {
+                    p = src->pnt;
+                    if (split != 0) {
+                        NuVecAdd(&p, &p, &gobj->origin);
+                    }
+                    NuVecMtxTransform(&vtx->pnt, &p, &gm);
+                    NuVecMtxRotate(&vtx->nrm, &src->nrm, &gm);
+                    vtx->diffuse = src->diffuse;
+                    vtx->tc[0] = src->tc[0];
+                    vtx->tc[1] = src->tc[1];
+                }
+                dst[k]->vtxcnt += geom->vtxcnt;
+            }
+        }
+    }
+    for (k = 0; k < nmtl; k++) {
+        dst[k]->vtxmax = dst[k]->vtxcnt;
+        dst[k]->prim->cnt = (u16)(out[k] - (u16*)dst[k]->prim->idxbuff);
+        dst[k]->prim->max = dst[k]->prim->cnt;
+    }
+    NuGobjCalcDims(e->gobj);
+    return 1;
+}
+
+static void Font3DCacheDraw(struct font3dcache_s* e, float x, float y, float z, float scalex, float scaley, float scalez, s32 align) {
+    volatile FONT3DOBJECT* obj;
+    struct font3dcacheicon_s* icon;
+    struct numtx_s m;
+    struct nuvec_s s;
+    float xpulsescale;
+    float x0;
+    float ix;
+    float iy;
+    s32 i;
+
+    xpulsescale = 1.0f;
+    x0 = x + (scalex * 0.1f) * (e->xstart - 0.5f);
+    if (((disable_safearea_clamp == 0) && (x0 < -0.81f)) && (x0 > -1.3f)) {
+        scalex = (scalex * ((-0.81f - x) / (x0 - x)));
+        xpulsescale = 0.5f;
+    }
+    if ((align & 0x20) != 0) {
+        scalex = (scalex * ((menu_pulsate - 1.0f) * xpulsescale + 1.0f));
+        scaley = (scaley * menu_pulsate);
+        scalez = (scalez * menu_pulsate);
+    }
+    font3d_dx = (scalex * 0.1f);
+    font3d_dy = (scaley * 0.1f) * FONT3DYMUL;
+    font3d_xleft = x + font3d_dx * (e->xstart - 0.5f);
+    font3d_xright = x + font3d_dx * (e->xend - 0.5f);
+    font3d_xmid = (font3d_xleft + font3d_xright) * 0.5f;
+    font3d_ymid = y + font3d_dy * e->yoff;
+    font3d_ytop = font3d_ymid + font3d_dy * 0.5f;
+    font3d_ybottom = font3d_ymid - font3d_dy * 0.5f;
+    if ((scalex == 0.0f) && (scaley == 0.0f) && (scalez == 0.0f)) {
+        return;
+    }
+
+    // the pulse and the safe area squash are just this one matrix
+    if (e->gobj != NULL) {
+        s.x = scalex;
+        s.y = scaley;
+        s.z = scalez;
+        NuMtxSetScale(&m, &s);
+        m._30 = x * PANEL3DMULX;
+        m._31 = y * PANEL3DMULY;
+        m._32 = z;
+        NuMtxMul(&m, &m, NuCameraGetMtx());
+        SetLevelLights();
+        nurndr_forced_mtl_table = NULL;
+        NuRndrGScnObj(e->gobj, &m);
+    }
+    for (i = 0, icon = e->icon; i < e->nicons; i++, icon++) {
+        obj = &Font3DObjTab[icon->obj];
+        if (obj->i == -1) {
+            continue;
+        }
+        ix = x + font3d_dx * icon->ux;
+        iy = y + font3d_dy * icon->uy;
+        nurndr_forced_mtl_table = icon->mtltab;
+        if ((obj->flags & 2) != 0) {
+            if (ObjTab[obj->i].obj.special != NULL) {
+                DrawPanel3DObject(obj->i, ix, iy, z, (obj->scale * scalex), (obj->scale * scaley), (obj->scale * scalez), 0, 0, 0,
+                                  ObjTab[obj->i].obj.scene, ObjTab[obj->i].obj.special, 1);
+            }
+        } else if ((obj->flags & 1) != 0) {
+            DrawPanel3DCharacter(obj->i, ix, iy, z, (obj->scale * scalex), (obj->scale * scaley), (obj->scale * scalez), 0, 0, 0,
+                                 obj->action, obj->anim_time, 1);
+        }
+    }
+    nurndr_forced_mtl_table = NULL;
+}
+
+// Draw txt from the cache, building its entry the first time. Returns 0 if Text3D has to draw it letter by letter.
+static s32 Text3DCached(char* txt, float x, float y, float z, float scalex, float scaley, float scalez, s32 align, s32 colour) {
+    struct font3dcache_s* e;
+    struct font3dcache_s* victim;
+    u32 hash;
+    s32 n;
+    s32 i;
+
+    // Japanese pairs and forced materials aren't worth a cache entry
+    if ((Game.language == 0x63) || (nurndr_forced_mtl != NULL) || (strlen(txt) >= FONT3D_CACHELEN)) {
+        return 0;
+    }
+    colour = ((u32)colour < 5) ? colour : 0;
+    hash = Font3DCacheHash(txt);
+    victim = NULL;
+    for (i = 0, e = font3d_cache; i < FONT3D_CACHESIZE; i++, e++) {
+        if (e->txt[0] == 0) {
+            if (victim == NULL || victim->txt[0] != 0) {
+                victim = e;
+            }
+            continue;
+        }
+        if ((e->hash == hash) && (e->align == (align & 0x1e)) && (e->colour == colour) && (e->mulx == PANEL3DMULX)
+            && (e->muly == PANEL3DMULY) && (strcmp(e->txt, txt) == 0)) {
+            break;
+        }
+        // anything queued this scene is still referenced by the render lists
+        if ((e->scene != NuRndrSceneCount) && ((victim == NULL) || ((victim->txt[0] != 0) && (e->used < victim->used)))) {
+            victim = e;
+        }
+    }
+    if (i == FONT3D_CACHESIZE) {
+        if (victim == NULL) {
+            return 0;
+        }
+        e = victim;
+        Font3DCacheFree(e);
+        strcpy(e->txt, txt);
+        e->hash = hash;
+        e->align = align & 0x1e;
+        e->colour = colour;
+        e->mulx = PANEL3DMULX;
+        e->muly = PANEL3DMULY;
+        n = Font3DCacheLayout(e);
+        e->failed = ((n < 0) || (Font3DCacheBuild(e, n) == 0));
+    }
+    e->used = ++font3d_cacheclock;
+    if (e->failed != 0) {
+        return 0;
+    }
+    e->scene = NuRndrSceneCount;
+    Font3DCacheDraw(e, x, y, z, scalex, scaley, scalez, align);
+    return 1;
+}
+
 void Text3D(char* txt, float x, float y, float z, float scalex, float scaley, float scalez, s32 align, s32 colour) {
     s32 i;
     s32 j;
@@ -292,6 +822,9 @@ void Text3D(char* txt, float x, float y, float z, float scalex, float scaley, fl
     if (l < 1) {
         return;
     }
+    if (Text3DCached(txt, x, y, z, scalex, scaley, scalez, align, colour) != 0) {
+        return;
+    }
     
     f28 = dx = 0.0f;
     for (i = 0; txt[i] != 0; i++) {
@@ -42,4 +42,7 @@ typedef struct {
 volatile FONT3DOBJECT Font3DObjTab[26];
 volatile FONT3DCHARACTER Font3DTab[62];
 
+// Text3D keeps the merged glyphs of recent strings, drop them all.
+void Font3DCacheFlush(void);
+
 #endif // !FONT3D_H
@@ -11,13 +11,172 @@
 	DrawProjectiles
 */
 
-//NGC MATCH
+// Spatial hash of game objects, rebuilt after ProcessCreatures.
+// pObj never holds more than 0x40 objects, so each XZ cell bucket is a bitmask of object slots and queries return
+// the union of the buckets they touch. Callers still run their exact tests on the objects in the mask.
+#define OBJHASHSIZE 512
+#define OBJHASHCELL 2.0f
+#define OBJHASHPAD 0.5f
+#define OBJHASHMAXCELLS 64
+
+static u64 ObjHash[OBJHASHSIZE];
+static u64 ObjHashLarge;
+static s32 ObjHashValid;
+
+static s32 ObjHashIndex(s32 x, s32 z) {
+    return (((u32)x * 73856093) ^ ((u32)z * 19349663)) & (OBJHASHSIZE - 1);
+}
+
+// Where the collision code treats the object as standing.
+static void GameObjectHashPos(struct obj_s* obj, struct nuvec_s* pos) {
+    if (((obj->flags & 0x2000) != 0) && (obj->pLOCATOR != NULL) && ((obj->model == NULL) || (obj->model->pLOCATOR[0] != NULL))) {
+        pos->x = obj->pLOCATOR->_30;
+        pos->y = obj->pLOCATOR->_31;
+        pos->z = obj->pLOCATOR->_32;
+    }
+    else {
+        *pos = obj->pos;
+    }
+    return;
+}
+
+static u64 GameObjectHashCircle(float x, float z, float r) {
+    u64 mask;
+    s32 x0;
+    s32 z0;
+    s32 x1;
+    s32 z1;
+    s32 cx;
+    s32 cz;
+
+    x0 = (s32)floor((x - r) / OBJHASHCELL);
+    x1 = (s32)floor((x + r) / OBJHASHCELL);
+    z0 = (s32)floor((z - r) / OBJHASHCELL);
+    z1 = (s32)floor((z + r) / OBJHASHCELL);
+    if ((x1 - x0 + 1) * (z1 - z0 + 1) > OBJHASHMAXCELLS) {
+        return ~(u64)0;
+    }
+    mask = ObjHashLarge;
+    for (cz = z0; cz <= z1; cz++) {
+        for (cx = x0; cx <= x1; cx++) {
+            mask |= ObjHash[ObjHashIndex(cx, cz)];
+        }
+    }
+    return mask;
+}
+
+// Walk the XZ cells crossed by the segment p0 -> p1 (grid DDA) and collect their objects.
+static u64 GameObjectHashRay(struct nuvec_s* p0, struct nuvec_s* p1) {
+    u64 mask;
+    float dx;
+    float dz;
+    float tmaxx;
+    float tmaxz;
+    float tdx;
+    float tdz;
+    s32 cx;
+    s32 cz;
+    s32 ex;
+    s32 ez;
+    s32 sx;
+    s32 sz;
+    s32 n;
+
+    cx = (s32)floor(p0->x / OBJHASHCELL);
+    cz = (s32)floor(p0->z / OBJHASHCELL);
+    ex = (s32)floor(p1->x / OBJHASHCELL);
+    ez = (s32)floor(p1->z / OBJHASHCELL);
+    n = ((ex > cx) ? (ex - cx) : (cx - ex)) + ((ez > cz) ? (ez - cz) : (cz - ez)) + 1;
+    if (n > OBJHASHMAXCELLS) {
+        return ~(u64)0;
+    }
+    dx = p1->x - p0->x;
+    dz = p1->z - p0->z;
+    sx = (dx > 0.0f) ? 1 : -1;
+    sz = (dz > 0.0f) ? 1 : -1;
+    tdx = (dx != 0.0f) ? NuFabs(OBJHASHCELL / dx) : 1e30f;
+    tdz = (dz != 0.0f) ? NuFabs(OBJHASHCELL / dz) : 1e30f;
+    tmaxx = (dx != 0.0f) ? ((((sx > 0) ? (cx + 1) : cx) * OBJHASHCELL - p0->x) / dx) : 1e30f;
+    tmaxz = (dz != 0.0f) ? ((((sz > 0) ? (cz + 1) : cz) * OBJHASHCELL - p0->z) / dz) : 1e30f;
+    mask = ObjHashLarge;
+    for (; n > 0; n--) {
+        mask |= ObjHash[ObjHashIndex(cx, cz)];
+        if (tmaxx < tmaxz) {
+            tmaxx += tdx;
+            cx += sx;
+        }
+        else {
+            tmaxz += tdz;
+            cz += sz;
+        }
+    }
+    return mask;
+}
+
+void InvalidateGameObjectHash(void) {
+    ObjHashValid = 0;
+    return;
+}
+
+void BuildGameObjectHash(void) {
+    struct obj_s* obj;
+    struct nuvec_s pos;
+    float r;
+    float e;
+    s32 x0;
+    s32 z0;
+    s32 x1;
+    s32 z1;
+    s32 cx;
+    s32 cz;
+    s32 i;
+
+    memset(ObjHash, 0, sizeof(ObjHash));
+    ObjHashLarge = 0;
+    for (i = 0; i < GAMEOBJECTCOUNT; i++) {
+        obj = pObj[i];
+        if (obj == NULL) {
+            continue;
+        }
+        GameObjectHashPos(obj, &pos);
+        r = obj->RADIUS;
+        if ((obj->flags & 0x8000) != 0) {
+            e = NuFabs((obj->min).x);
+            e = (NuFabs((obj->max).x) > e) ? NuFabs((obj->max).x) : e;
+            e = (NuFabs((obj->min).z) > e) ? NuFabs((obj->min).z) : e;
+            e = (NuFabs((obj->max).z) > e) ? NuFabs((obj->max).z) : e;
+            e *= obj->SCALE * 1.4142135f;
+            r = (e > r) ? e : r;
+        } else {
+            // the ray test uses a RADIUS sized box turned with the object, its corners reach RADIUS * sqrt 2
+            r *= 1.4142135f;
+        }
+        r += OBJHASHPAD;
+        x0 = (s32)floor((pos.x - r) / OBJHASHCELL);
+        x1 = (s32)floor((pos.x + r) / OBJHASHCELL);
+        z0 = (s32)floor((pos.z - r) / OBJHASHCELL);
+        z1 = (s32)floor((pos.z + r) / OBJHASHCELL);
+        if ((x1 - x0 + 1) * (z1 - z0 + 1) > OBJHASHMAXCELLS) {
+            ObjHashLarge |= (u64)1 << i;
+            continue;
+        }
+        for (cz = z0; cz <= z1; cz++) {
+            for (cx = x0; cx <= x1; cx++) {
+                ObjHash[ObjHashIndex(cx, cz)] |= (u64)1 << i;
+            }
+        }
+    }
+    ObjHashValid = 1;
+    return;
+}
+
 void ClearGameObjects(void) {
   s32 i;
   
   for (i = 0; i < 0x40; i++) {
     pObj[i] = NULL;
   }
+  ObjHashValid = 0;
   return;
 }
 
@@ -50,7 +209,6 @@ void ResetGameObject(struct obj_s *obj) {
   return;
 }
 
-//NGC MATCH
 s32 AddGameObject(struct obj_s *obj,void *parent) {
   s32 i;
   s32 ok;
@@ -65,6 +223,7 @@ s32 AddGameObject(struct obj_s *obj,void *parent) {
     pObj[i] = obj;
     obj->parent = (struct obj_s *)parent;
     obj->i = i;
+    ObjHashValid = 0;
   }
   else {
     ok = 0;
@@ -73,7 +232,6 @@ s32 AddGameObject(struct obj_s *obj,void *parent) {
   return ok;
 }
 
-//NGC MATCH
 void RemoveGameObject(struct obj_s *obj) 
 {
     int i;
@@ -83,7 +241,7 @@ void RemoveGameObject(struct obj_s *obj)
         if (pObj[i] == obj) 
         {
             pObj[i] = NULL;
-            
+            ObjHashValid = 0;
             i = 64;
         }
     }
@@ -746,15 +904,24 @@ void PickupItem(struct obj_s* obj) {
     return;
 }
 
-//NGC MATCH
 s32 HitItems(struct obj_s *obj) {
   struct obj_s *cyl;
+  struct nuvec_s pos;
+  u64 mask;
   s32 i;
   
   if (level_part_2 != 0) {
     return 0;
   }
+  mask = ~(u64)0;
+  if (ObjHashValid != 0) {
+      GameObjectHashPos(obj,&pos);
+      mask = GameObjectHashCircle(pos.x,pos.z,obj->RADIUS);
+  }
   for(i = 0; i < 64; i++) {
+      if (((mask >> i) & 1) == 0) {
+          continue;
+      }
       cyl = pObj[i];
       if ((((cyl != NULL) && (cyl->dead == 0)) && (cyl->invisible == 0)) &&
          (((cyl->flags & 0x10) != 0 && (GameObjectOverlap(obj,cyl,0) != 0)))) {
@@ -765,16 +932,25 @@ s32 HitItems(struct obj_s *obj) {
   return 0;
 }
 
-//NGC MATCH
 s32 HitCreatures(struct obj_s *obj, s32 destroy, s32 type) {
     struct obj_s *cyl;
+    struct nuvec_s pos;
+    u64 mask;
     s32 i; 
     s32 temp;
   
     if (level_part_2 != 0) {
         return 0;
     }
+    mask = ~(u64)0;
+    if (ObjHashValid != 0) {
+        GameObjectHashPos(obj,&pos);
+        mask = GameObjectHashCircle(pos.x,pos.z,obj->RADIUS);
+    }
     for (i = 0; i < 64; i++) { 
+        if (((mask >> i) & 1) == 0) {
+            continue;
+        }
         cyl = pObj[i];
         
         if ((((cyl != NULL) && (cyl->dead == 0)) && (cyl->invisible == 0)) &&
@@ -845,7 +1021,6 @@ s32 WipeCreatures(struct RPos_s *rpos) {
   return 0;
 }
 
-//NGC MATCH
 s32 CreatureRayCast(struct nuvec_s *p0,struct nuvec_s *p1) {
     struct nuvec_s v0;
     struct nuvec_s v1;
@@ -853,12 +1028,17 @@ s32 CreatureRayCast(struct nuvec_s *p0,struct nuvec_s *p1) {
     struct nuvec_s min;
     struct nuvec_s max;
     struct obj_s *obj;
+    u64 mask;
     s32 i;
     s32 face;
     float ratio;
     
     ratio = 1.0f;
+    mask = (ObjHashValid != 0) ? GameObjectHashRay(p0,p1) : ~(u64)0;
     for(i = 0; i < GAMEOBJECTCOUNT; i++) {
+        if (((mask >> i) & 1) == 0) {
+            continue;
+        }
         obj = pObj[i];
         if ((obj != NULL) && (obj->invisible == 0) && (obj->flags & 0x14) != 0) {
             if ((obj->flags & 0x2000) != 0) {
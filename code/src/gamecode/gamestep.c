@@ -0,0 +1,231 @@
+#include "gamecode/main.h"
+#include "gamecode/gamestep.h"
+#include "../../include/SDL/SDL_timer.h"
+
+// Moves bigger than this in one substep are teleports and aren't interpolated.
+#define GAMESTEP_SNAP 4.0f
+#define GAMESTEP_CREATURES 9
+
+s32 GameStepMaxSubsteps = 4;
+s32 GameStepSubsteps;
+float GameStepSubstepMs;
+float GameStepAlpha;
+s32 GameStepReport;
+
+struct gamestepstate_s {
+    struct numtx_s cam;
+    struct nuvec_s campos;
+    struct nuvec_s pos[GAMESTEP_CREATURES];
+    u16 hdg[GAMESTEP_CREATURES];
+};
+
+static struct gamestepstate_s gamestep_prev;
+static struct gamestepstate_s gamestep_cur;
+static struct numtx_s* gamestep_previnst;
+static struct numtx_s* gamestep_curinst;
+static s32 gamestep_ninst;
+static s32 gamestep_valid;
+static s32 gamestep_swapped;
+static u32 gamestep_lastticks;
+static u32 gamestep_substepticks;
+static float gamestep_accum;
+static s32 gamestep_reportframes;
+static s32 gamestep_reportsteps;
+
+static void GameStepGrab(struct gamestepstate_s* s, struct numtx_s* inst) {
+    struct nugscn_s* scn;
+    s32 i;
+
+    s->cam = GameCam[0].m;
+    s->campos = GameCam[0].pos;
+    for (i = 0; i < GAMESTEP_CREATURES; i++) {
+        s->pos[i] = Character[i].obj.pos;
+        s->hdg[i] = Character[i].obj.hdg;
+    }
+    scn = world_scene[0];
+    if ((scn != NULL) && (inst != NULL)) {
+        for (i = 0; i < gamestep_ninst; i++) {
+            if (scn->instances[i].anim != NULL) {
+                inst[i] = scn->instances[i].anim->mtx;
+            }
+        }
+    }
+}
+
+static void GameStepPut(struct gamestepstate_s* s, struct numtx_s* inst) {
+    struct nugscn_s* scn;
+    s32 i;
+
+    GameCam[0].m = s->cam;
+    GameCam[0].pos = s->campos;
+    // the view is set from pNuCam, as MoveGameCamera does
+    if (pNuCam != NULL) {
+        pNuCam->mtx = s->cam;
+        NuCameraSet(pNuCam);
+    }
+    for (i = 0; i < GAMESTEP_CREATURES; i++) {
+        Character[i].obj.pos = s->pos[i];
+        Character[i].obj.hdg = s->hdg[i];
+    }
+    scn = world_scene[0];
+    if ((scn != NULL) && (inst != NULL)) {
+        for (i = 0; i < gamestep_ninst; i++) {
+            if (scn->instances[i].anim != NULL) {
+                scn->instances[i].anim->mtx = inst[i];
+            }
+        }
+    }
+}
+
+static s32 GameStepFar(struct nuvec_s* a, struct nuvec_s* b) {
+    return (NuFabs(a->x - b->x) + NuFabs(a->y - b->y) + NuFabs(a->z - b->z)) > GAMESTEP_SNAP;
+}
+
+static void GameStepLerpVec(struct nuvec_s* dest, struct nuvec_s* a, struct nuvec_s* b, float t) {
+    dest->x = a->x + (b->x - a->x) * t;
+    dest->y = a->y + (b->y - a->y) * t;
+    dest->z = a->z + (b->z - a->z) * t;
+}
+
+// Row lerp, good enough for the small turns an instance makes in one substep.
+static void GameStepLerpMtx(struct numtx_s* dest, struct numtx_s* a, struct numtx_s* b, float t) {
+    float* d = (float*)dest;
+    float* fa = (float*)a;
+    float* fb = (float*)b;
+    s32 i;
+
+    if (GameStepFar((struct nuvec_s*)&a->_30, (struct nuvec_s*)&b->_30)) {
+        *dest = *b;
+        return;
+    }
+    for (i = 0; i < 16; i++) {
+        d[i] = fa[i] + (fb[i] - fa[i]) * t;
+    }
+}
+
+void GameStepReset(void) {
+    struct nugscn_s* scn;
+
+    gamestep_accum = 0.0f;
+    gamestep_valid = 0;
+    gamestep_swapped = 0;
+    gamestep_lastticks = SDL_GetTicks();
+
+    scn = world_scene[0];
+    if ((scn != NULL) && (scn->numinstance > gamestep_ninst)) {
+        free(gamestep_previnst);
+        free(gamestep_curinst);
+        gamestep_previnst = (struct numtx_s*)malloc(scn->numinstance * sizeof(struct numtx_s));
+        gamestep_curinst = (struct numtx_s*)malloc(scn->numinstance * sizeof(struct numtx_s));
+        if ((gamestep_previnst == NULL) || (gamestep_curinst == NULL)) {
+            free(gamestep_previnst);
+            free(gamestep_curinst);
+            gamestep_previnst = NULL;
+            gamestep_curinst = NULL;
+        }
+    }
+    gamestep_ninst = ((scn != NULL) && (gamestep_previnst != NULL)) ? scn->numinstance : 0;
+}
+
+s32 GameStepBegin(void) {
+    u32 ticks;
+    s32 steps;
+
+    // never draw without simulating, wait out the rest of the substep instead
+    ticks = SDL_GetTicks();
+    gamestep_accum += (ticks - gamestep_lastticks) * (GAMESTEP_HZ / 1000.0f);
+    if (gamestep_accum < 1.0f) {
+        SDL_Delay((u32)((1.0f - gamestep_accum) * (1000.0f / GAMESTEP_HZ)));
+        gamestep_accum = 1.0f;
+        ticks = SDL_GetTicks();
+    }
+    gamestep_lastticks = ticks;
+
+    steps = (s32)gamestep_accum;
+    if (steps > GameStepMaxSubsteps) {
+        steps = GameStepMaxSubsteps;
+        gamestep_accum = (float)steps;
+    }
+    gamestep_accum -= steps;
+    GameStepAlpha = gamestep_accum;
+    GameStepSubsteps = steps;
+
+    if (GameStepReport != 0) {
+        gamestep_reportframes++;
+        gamestep_reportsteps += steps;
+        if (gamestep_reportframes >= GAMESTEP_HZ * 5) {
+            printf("GameStep: %.2f substeps a frame, %.2f ms a substep\n",
+                   (float)gamestep_reportsteps / gamestep_reportframes, GameStepSubstepMs);
+            gamestep_reportframes = 0;
+            gamestep_reportsteps = 0;
+        }
+    }
+    return steps;
+}
+
+void GameStepSubstepBegin(void) {
+    GameStepGrab(&gamestep_prev, gamestep_previnst);
+    gamestep_valid = 1;
+    gamestep_substepticks = SDL_GetTicks();
+}
+
+void GameStepSubstepEnd(void) {
+    GameStepSubstepMs = GameStepSubstepMs * 0.9f + (float)(SDL_GetTicks() - gamestep_substepticks) * 0.1f;
+}
+
+void GameStepInterpolate(void) {
+    struct gamestepstate_s s;
+    struct nugscn_s* scn;
+    struct Quat qa;
+    struct Quat qb;
+    struct Quat q;
+    s32 i;
+    float t;
+
+    if ((gamestep_valid == 0) || (gamestep_swapped != 0)) {
+        return;
+    }
+    t = GameStepAlpha;
+    GameStepGrab(&gamestep_cur, gamestep_curinst);
+
+    if (GameStepFar(&gamestep_prev.campos, &gamestep_cur.campos)) {
+        s.cam = gamestep_cur.cam;
+        s.campos = gamestep_cur.campos;
+    } else {
+        NuMtxToQuat((struct Mtx*)&gamestep_prev.cam, &qa);
+        NuMtxToQuat((struct Mtx*)&gamestep_cur.cam, &qb);
+        NuQuatSlerp(t, &q, &qa, &qb);
+        NuQuatToMtx(&q, (struct Mtx*)&s.cam);
+        GameStepLerpVec((struct nuvec_s*)&s.cam._30, (struct nuvec_s*)&gamestep_prev.cam._30, (struct nuvec_s*)&gamestep_cur.cam._30, t);
+        GameStepLerpVec(&s.campos, &gamestep_prev.campos, &gamestep_cur.campos, t);
+    }
+
+    for (i = 0; i < GAMESTEP_CREATURES; i++) {
+        if (GameStepFar(&gamestep_prev.pos[i], &gamestep_cur.pos[i])) {
+            s.pos[i] = gamestep_cur.pos[i];
+            s.hdg[i] = gamestep_cur.hdg[i];
+        } else {
+            GameStepLerpVec(&s.pos[i], &gamestep_prev.pos[i], &gamestep_cur.pos[i], t);
+            s.hdg[i] = gamestep_prev.hdg[i] + (s32)((s16)(gamestep_cur.hdg[i] - gamestep_prev.hdg[i]) * t);
+        }
+    }
+
+    GameStepPut(&s, NULL);
+    scn = world_scene[0];
+    if ((scn != NULL) && (gamestep_curinst != NULL)) {
+        for (i = 0; i < gamestep_ninst; i++) {
+            if (scn->instances[i].anim != NULL) {
+                GameStepLerpMtx(&scn->instances[i].anim->mtx, &gamestep_previnst[i], &gamestep_curinst[i], t);
+            }
+        }
+    }
+    gamestep_swapped = 1;
+}
+
+void GameStepRestore(void) {
+    if (gamestep_swapped == 0) {
+        return;
+    }
+    GameStepPut(&gamestep_cur, gamestep_curinst);
+    gamestep_swapped = 0;
+}
@@ -0,0 +1,45 @@
+#ifndef GAMESTEP_H
+#define GAMESTEP_H
+
+#include "../types.h"
+
+/*
+  Fixed rate simulation for the main loop. GameStepBegin turns the real time since the last frame into
+  a count of 1/60th second substeps, capped at GameStepMaxSubsteps so a slow frame can't snowball.
+  Call GameStepSubstepBegin / GameStepSubstepEnd around each substep, then GameStepInterpolate before drawing
+  and GameStepRestore after it: the frame is drawn between the last two simulated states, GameStepAlpha of the way.
+*/
+
+#define GAMESTEP_HZ 60
+
+// Most substeps a frame may run, time beyond that is dropped.
+extern s32 GameStepMaxSubsteps;
+
+// Substeps run for the last frame.
+extern s32 GameStepSubsteps;
+
+// Smoothed real time per substep in ms.
+extern float GameStepSubstepMs;
+
+// Where between the previous and current simulated state the frame is drawn.
+extern float GameStepAlpha;
+
+// Print substep stats every few seconds.
+extern s32 GameStepReport;
+
+// Forget the accumulated time and the saved states, call when a level (re)starts.
+void GameStepReset(void);
+
+// Returns the number of substeps to run this frame, at least 1.
+s32 GameStepBegin(void);
+
+void GameStepSubstepBegin(void);
+void GameStepSubstepEnd(void);
+
+// Swap the interpolated camera, creature and instance transforms in for drawing.
+void GameStepInterpolate(void);
+
+// Put the simulated transforms back, does nothing if GameStepInterpolate wasn't called.
+void GameStepRestore(void);
+
+#endif // !GAMESTEP_H
@@ -1,23 +1,23 @@
 #include "gamecode/inst.h"
 
-static struct nulsthdr_s* sceneinst_pool;
-static struct nulsthdr_s* animdatainst_pool;
+static struct nupool_s* sceneinst_pool;
+static struct nupool_s* animdatainst_pool;
 
 //PS2
 struct nuscene_s * InstSceneLoad(char *name)
 {
   struct sceneinst_s *sc;
 
-    sc = (struct sceneinst_s *)NuLstGetNext(sceneinst_pool,NULL);
+    sc = (struct sceneinst_s *)NuPoolGetNext(sceneinst_pool,NULL);
     while(sc != NULL) {
         if (strcasecmp(name, sc->name) == 0) {
             sc->inst_cnt++;
             return sc->scene;
         }
-        sc = (struct sceneinst_s *)NuLstGetNext(sceneinst_pool,(struct nulnkhdr_s *)sc);
+        sc = (struct sceneinst_s *)NuPoolGetNext(sceneinst_pool,sc);
     }
 
-    sc = (struct sceneinst_s *)NuLstAlloc(sceneinst_pool);
+    sc = (struct sceneinst_s *)NuPoolAlloc(sceneinst_pool);
     if (sc != NULL) {
         sc->scene = NuSceneLoad(name);
         if (sc->scene != NULL) {
@@ -25,7 +25,7 @@ struct nuscene_s * InstSceneLoad(char *name)
             sc->inst_cnt = 1;
             return sc->scene;
         } else {
-            NuLstFree((struct nulnkhdr_s *)sc);
+            NuPoolFree(sceneinst_pool,sc);
         }
     }
 
@@ -41,16 +41,16 @@ struct nuanimdata_s * InstAnimDataLoad(char *name)
 
     // can also be a for loop
     // for (sc =NuLstGetNext(animdatainst_pool, NULL); sc != 0; sc = NuLstGetNext(animdatainst_pool,sc))
-    sc = (struct animdatainst_s *)NuLstGetNext(animdatainst_pool, NULL);
+    sc = (struct animdatainst_s *)NuPoolGetNext(animdatainst_pool,NULL);
     while(sc != 0) {
         if (strcasecmp(name, sc->name) == 0) {
             sc->inst_cnt++;
             return sc->ad;
         }
-        sc = (struct animdatainst_s *)NuLstGetNext(animdatainst_pool, (struct nulnkhdr_s *)sc);
+        sc = (struct animdatainst_s *)NuPoolGetNext(animdatainst_pool,sc);
     }
 
-    lst = (struct animdatainst_s *)NuLstAlloc(animdatainst_pool);
+    lst = (struct animdatainst_s *)NuPoolAlloc(animdatainst_pool);
     if (lst != NULL) {
         adat = NuAnimDataLoadBuff(name, &superbuffer_ptr, &superbuffer_end);
         lst->ad = adat;
@@ -59,7 +59,7 @@ struct nuanimdata_s * InstAnimDataLoad(char *name)
             lst->inst_cnt = 1;
             return lst->ad;
         } else {
-            NuLstFree((struct nulnkhdr_s *)lst);
+            NuPoolFree(animdatainst_pool,lst);
         }
     }
 
@@ -70,8 +70,8 @@ struct nuanimdata_s * InstAnimDataLoad(char *name)
 void InstInit(void)
 
 {
-  sceneinst_pool = NuLstCreate(0x10,0x108);
-  animdatainst_pool = NuLstCreate(0xc0,0x108);
+  sceneinst_pool = NuPoolCreate(0x10,0x108);
+  animdatainst_pool = NuPoolCreate(0xc0,0x108);
   return;
 }
 
@@ -92,22 +92,22 @@ void InstClose(void)
     shaddatainst_pool = NULL;
   }	*/
   if (animdatainst_pool != NULL) {
-    adi = (struct animdatainst_s *)NuLstGetNext(animdatainst_pool,NULL);
+    adi = (struct animdatainst_s *)NuPoolGetNext(animdatainst_pool,NULL);
     while (adi != NULL)
     {
-        adi = (struct animdatainst_s *)NuLstGetNext(animdatainst_pool,(struct nulnkhdr_s *)adi);
+        adi = (struct animdatainst_s *)NuPoolGetNext(animdatainst_pool,adi);
     }
-    NuLstDestroy(animdatainst_pool);
+    NuPoolDestroy(animdatainst_pool);
     animdatainst_pool = NULL;
   }
 
   if (sceneinst_pool != NULL) {
-    si = (struct sceneinst_s *)NuLstGetNext(sceneinst_pool,NULL);
+    si = (struct sceneinst_s *)NuPoolGetNext(sceneinst_pool,NULL);
     while (si != NULL) {
       NuSceneDestroy(si->scene);
-      si = (struct sceneinst_s *)NuLstGetNext(sceneinst_pool,(struct nulnkhdr_s *)si);
+      si = (struct sceneinst_s *)NuPoolGetNext(sceneinst_pool,si);
     }
-    NuLstDestroy(sceneinst_pool);
+    NuPoolDestroy(sceneinst_pool);
     sceneinst_pool = NULL;
   }
   return;
@@ -2,6 +2,7 @@
 #include "../nu.h"
 #include "gamecode/main.h"
 #include "nu3dx/nu3dxtypes.h"
+#include <stdint.h>
 
 
 union Lst
@@ -121,3 +122,149 @@ struct nulnkhdr_s * NuLstGetNext(struct nulsthdr_s *hdr,struct nulnkhdr_s *lnk)
 }
 
 
+
+struct nupool_s* NuPoolCreate(s32 elcnt, s32 elsize)
+{
+    struct nupool_s* pool;
+    s32 n;
+
+    if (elcnt > 0xffff) {
+        NuErrorProlog("OpenCrashWOC/code/gamecode/listman.c", __LINE__)("NuPoolCreate : %d elements is too many", elcnt);
+        return NULL;
+    }
+    pool = (struct nupool_s *)NuMemAlloc(sizeof(struct nupool_s) + elcnt * (elsize + sizeof(u16) * 4) + 0x10);
+    if (pool != NULL) {
+        pool->data = (u8 *)(((uintptr_t)(pool + 1) + 0xf) & ~(uintptr_t)0xf);
+        pool->slotof = (u16 *)(pool->data + elcnt * elsize);
+        pool->handleof = pool->slotof + elcnt;
+        pool->gen = pool->handleof + elcnt;
+        pool->freenext = pool->gen + elcnt;
+        pool->elcnt = elcnt;
+        pool->elsize = elsize;
+        pool->count = 0;
+        for (n = 0; n < elcnt; n++) {
+            pool->gen[n] = 1;
+            pool->freenext[n] = n + 2; // next index + 1
+        }
+        if (elcnt > 0) {
+            pool->freenext[elcnt - 1] = 0;
+        }
+        pool->freehead = (elcnt > 0) ? 1 : 0;
+    }
+    return pool;
+}
+
+void NuPoolDestroy(struct nupool_s* pool)
+{
+    NuMemFree(pool);
+}
+
+// Pop a handle index off the free list. The tag in the top half stops a pop racing a pop/push pair (ABA).
+static s32 NuPoolPopHandle(struct nupool_s* pool)
+{
+    s32 head;
+    s32 next;
+
+    do {
+        head = pool->freehead;
+        if ((head & 0xffff) == 0) {
+            return -1;
+        }
+        next = (head & 0xffff0000) + 0x10000;
+        next |= pool->freenext[(head & 0xffff) - 1];
+    } while (NuAtomicCas32(&pool->freehead, head, next) != head);
+    return (head & 0xffff) - 1;
+}
+
+static void NuPoolPushHandle(struct nupool_s* pool, s32 h)
+{
+    s32 head;
+
+    do {
+        head = pool->freehead;
+        pool->freenext[h] = head & 0xffff;
+    } while (NuAtomicCas32(&pool->freehead, head, ((head & 0xffff0000) + 0x10000) | (h + 1)) != head);
+}
+
+static void* NuPoolPlace(struct nupool_s* pool, s32 h, s32 pos)
+{
+    pool->slotof[h] = pos;
+    pool->handleof[pos] = h;
+    return pool->data + pos * pool->elsize;
+}
+
+void* NuPoolAlloc(struct nupool_s* pool)
+{
+    s32 h;
+
+    h = NuPoolPopHandle(pool);
+    if (h < 0) {
+        return NULL;
+    }
+    return NuPoolPlace(pool, h, pool->count++);
+}
+
+// Safe to call from several threads at once, but not alongside NuPoolFree or a walk of the pool.
+void* NuPoolAllocConcurrent(struct nupool_s* pool)
+{
+    s32 h;
+
+    h = NuPoolPopHandle(pool);
+    if (h < 0) {
+        return NULL;
+    }
+    return NuPoolPlace(pool, h, NuAtomicAdd32(&pool->count, 1) - 1);
+}
+
+void NuPoolFree(struct nupool_s* pool, void* el)
+{
+    s32 pos;
+    s32 last;
+    s32 h;
+
+    pos = ((u8 *)el - pool->data) / pool->elsize;
+    h = pool->handleof[pos];
+    last = pool->count - 1;
+    if (pos != last) {
+        memcpy(el, pool->data + last * pool->elsize, pool->elsize);
+        NuPoolPlace(pool, pool->handleof[last], pos);
+    }
+    pool->count = last;
+    pool->gen[h]++;
+    if (pool->gen[h] == 0) {
+        pool->gen[h] = 1;
+    }
+    NuPoolPushHandle(pool, h);
+}
+
+// Same walk as NuLstGetNext: pass NULL for the first element.
+void* NuPoolGetNext(struct nupool_s* pool, void* el)
+{
+    u8* next;
+
+    next = (el != NULL) ? ((u8 *)el + pool->elsize) : pool->data;
+    if (next >= pool->data + pool->count * pool->elsize) {
+        return NULL;
+    }
+    return next;
+}
+
+u32 NuPoolHandle(struct nupool_s* pool, void* el)
+{
+    s32 h;
+
+    h = pool->handleof[((u8 *)el - pool->data) / pool->elsize];
+    return ((u32)pool->gen[h] << 16) | h;
+}
+
+// NULL once the element has been freed.
+void* NuPoolGet(struct nupool_s* pool, u32 handle)
+{
+    s32 h;
+
+    h = handle & 0xffff;
+    if ((h >= pool->elcnt) || (pool->gen[h] != (handle >> 16))) {
+        return NULL;
+    }
+    return pool->data + pool->slotof[h] * pool->elsize;
+}
@@ -1,5 +1,6 @@
 #include "../nu.h"
 #include "gamecode/main.h"
+#include "gamecode/gamestep.h"
 /*
   8004f584 0000bc 8004f584  4 InitTexAnimScripts 	Global
   8004f640 000168 8004f640  4 SetTexAnimSignals 	Global
@@ -57,6 +58,7 @@ s32 SHEIGHT;
 s32 SWIDTH;
 s32 IsLoadingScreen;
 s32 FRAME;
+s32 FRAMES;
 char tbtxt[16][16];
 s32 i_tb_code;
 s32 app_tbset;
@@ -71,7 +73,6 @@ s32 GAMEOBJECTCOUNT; //game_obj.c
 char* tLOADING[6]; //text.c
 
 
-//NGC MATCH
 void ResetSuperBuffer(void) {
   if (superbuffersize != (double)0x4156eb851eb851ec) {
     if (superbuffer_base.voidptr != NULL) {
@@ -88,9 +89,9 @@ void ResetSuperBuffer(void) {
     }
   }
   superbuffer_ptr = superbuffer_reset_base;
+  NuMemTagSetSuper(&superbuffer_ptr,&superbuffer_base,&superbuffer_end);
 }
 
-//NGC MATCH
 void ResetSuperBuffer2(void) {
     if (superbuffersize != (double)6008340.48) {
         if (superbuffer_base.voidptr != NULL) {
@@ -106,6 +107,7 @@ void ResetSuperBuffer2(void) {
         }
     }
     superbuffer_ptr = superbuffer_reset_base;
+    NuMemTagSetSuper(&superbuffer_ptr,&superbuffer_base,&superbuffer_end);
 }
 
 void InitTexAnimScripts(void)	//PS2
@@ -396,9 +398,11 @@ void InitWorld(void) {
     noterraininit();
     
     if ((LDATA->flags & 8) != 0) {
+        NuMemPushTag(NUMEMTAG_TERRAIN);
         TerrainSetCur(superbuffer_ptr.voidptr);
         terraininit(Level, &superbuffer_ptr.s16, superbuffer_end.s16, 0, LevelFileName, world_scene[0], 0);
         superbuffer_ptr.intaddr = (uint)((s32) & (superbuffer_ptr.vec4)->w + 3) & 0xfffffff0;
+        NuMemPopTag();
     }
     
     crate_scene = NULL;
@@ -428,7 +432,9 @@ void InitWorld(void) {
     
     sprintf(tbuf, "%s.anm", LevelFileName);
     if (NuFileExists(tbuf) != 0) {
+        NuMemPushTag(NUMEMTAG_ANIM);
         edanimFileLoad(tbuf);
+        NuMemPopTag();
     }
     edgraClumpsReset();
     
@@ -445,6 +451,7 @@ void InitWorld(void) {
     
     LoadVehicleStuff();
     
+    NuMemPushTag(NUMEMTAG_CUTSCENE);
     if (Level == 0x27) {
         LoadCutMovie(1);
         StartCutMovie();
@@ -452,6 +459,7 @@ void InitWorld(void) {
         LoadCutMovie(3);
         StartCutMovie();
     }
+    NuMemPopTag();
     
     TerrainPlatformOldUpdate();
     if (world_scene[0] != NULL) {
@@ -465,8 +473,10 @@ void InitWorld(void) {
     TerrainPlatformNewUpdate();
     
     if (((LDATA->flags & 1) != 0) && (Level != 0x25)) {
+        NuMemPushTag(NUMEMTAG_TEXTURE);
         ShadowMat = CreateAlphaBlendTexture64("stuff\\gradient.raw", 0, 1, 100);
         ShadowMatBodge = ShadowMat->tid;
+        NuMemPopTag();
     }
     
     ResetCheckpoint(-1, -1, 0.0f, NULL);
@@ -514,10 +524,10 @@ void MAHLoadingMessage(void)
   return;
 }
 
-//NGC MATCH
 void LoadLevel(void) {
 
     loadcount++;
+    NuMemTagLevelReset();
     load_anim_data = NULL;
     hLoadScreenThread = NULL;
     InitXboxEffectSystem(Level);
@@ -532,11 +542,18 @@ void LoadLevel(void) {
     if (Level != 0x28) {
         MAHLoadingMessage();
     }
+    NuMemPushTag(NUMEMTAG_TEXTURE);
     InitTexAnimScripts();
+    NuMemPopTag();
+    NuMemPushTag(NUMEMTAG_ANIM);
     InitCreatureModels();
+    NuMemPopTag();
+    NuMemPushTag(NUMEMTAG_SCENE);
     if ((LBIT & 0x200000a1) != 0) {
         InitClouds(&superbuffer_ptr, &superbuffer_end);
     }
+    NuMemPopTag();
+    NuMemPushTag(NUMEMTAG_TEXTURE);
     if ((LDATA->flags & 0x40) != 0) {
         if (CrateMat == NULL) {
             if (CrateMat2 == NULL) {
@@ -545,15 +562,20 @@ void LoadLevel(void) {
             }
         }
     }
+    NuMemPopTag();
+    NuMemPushTag(NUMEMTAG_AUDIO);
     InitLocalSfx(LDATA->pSFX, (s32)LDATA->nSFX);
+    NuMemPopTag();
     InitSpecular();
     wumpa_scene = NULL;
+    NuMemPushTag(NUMEMTAG_SCENE);
     if ((LDATA->flags & 0x100) != 0) {
         wumpa_scene2 = NuSceneReader(&superbuffer_ptr, &superbuffer_end, "stuff\\wumpa.nus");
         if (wumpa_scene2 != NULL) {
             wumpa_scene = wumpa_scene2->gscene;
         }
     }
+    NuMemPopTag();
     
     {
         float arr0[2] = {0.625f, 0.75f};
@@ -563,21 +585,28 @@ void LoadLevel(void) {
     
     ClearGameObjects();
     ResetCheckpoint(-1, -1, 0.0f, NULL);
+    NuMemPushTag(NUMEMTAG_SCENE);
     InitWorld();
+    NuMemPopTag();
     i_cratetypedata = 0;
     if (((LDATA->flags & 0x40) != 0) && (ReadCrateData() != 0)) {
         ReadInCrateData();
     }
     LoadLights();
+    NuMemPushTag(NUMEMTAG_ANIM);
     InitCreatures();
+    NuMemPopTag();
+    NuMemPushTag(NUMEMTAG_DEBRIS);
     ParticleReset();
     InitParticleSystem();
+    NuMemPopTag();
     NuStopLoadScreen(0);
     if (Level == 7) {
         YTOL = 0.01166667f;
     } else {
         YTOL = 0.01f;
     }
+    NuMemTagDump("LoadLevel");
     return;
 }
 
@@ -933,7 +962,6 @@ void UnLoadGBABG(void) {
 
 /*
 
-//NGC MATCH
 void Reseter(void) {
   if (OSGetResetButtonState() != 0) {
     reset_256 = 1;
@@ -953,6 +981,8 @@ void Reseter(void) {
       VIFlush();
       OSReport("VIWaitForRetrace\n");
       VIWaitForRetrace();
+      OSReport("NuJobClose\n");
+      NuJobClose();
       OSReport("OSResetSystem\n");
       OSResetSystem(0,1,0);
     }
@@ -960,7 +990,6 @@ void Reseter(void) {
   return;
 }
 
-//NGC MATCH
 void Managememcard(void) {
   SS_StopAllSFX();
   SS_TrackStop(-1);
@@ -968,6 +997,7 @@ void Managememcard(void) {
   VISetBlack(1);
   VIFlush();
   VIWaitForRetrace();
+  NuJobClose();
   OSResetSystem(1,1,1);
   return;
 }
@@ -1172,6 +1202,151 @@ s32 main(int argc /* r3 */, char * * argv /* r4 */) {
 */
 
 
+// Resources the per substep update stages touch, see GameStages.
+#define GSTAGE_SCENE 0x1
+#define GSTAGE_BRIDGE 0x2
+#define GSTAGE_WIND 0x4
+#define GSTAGE_CHARS 0x8
+#define GSTAGE_LEVEL 0x10
+#define GSTAGE_DEBRIS 0x20
+#define GSTAGE_MTL 0x40
+#define GSTAGE_CAM 0x80
+#define GSTAGE_ALL 0xffffffff
+
+extern s32 level_part_2;
+extern s32 NODEBRIS;
+extern int GLASSPLAYER;
+extern float plr_invisibility_time;
+
+// Not a stage, NuGScnUpdate spreads the scene over the job pool itself and would run inline inside one.
+static void GameStageScene(void) {
+    if ((LDATA->flags & 8) != 0) {
+        TerrainPlatformOldUpdate();
+    }
+    if (world_scene[0] != NULL) {
+        NuGScnUpdate(world_scene[0],1.0f);
+    }
+}
+
+static void GameStageObjects(void) {
+    edobjUpdateObjects(1.0f);
+    edanimUpdateObjects(1.0f);
+    NuRndrWaterRippleUpdate(1);
+}
+
+static void GameStageBridges(void) {
+    NuBridgeUpdate(&Character[0].obj.pos);
+}
+
+static void GameStagePlatsNew(void) {
+    if ((LDATA->flags & 8) != 0) {
+        TerrainPlatformNewUpdate();
+    }
+}
+
+static void GameStageWind(void) {
+    NuWindUpdate(&Character[0].obj.pos);
+}
+
+static void GameStageChars(void) {
+    if ((LDATA->flags & 1) != 0) {
+        InvalidateGameObjectHash();
+        ManageCreatures();
+        ProcessCreatures();
+        BuildGameObjectHash();
+    }
+}
+
+static void GameStageUpdate(void) {
+    if (Cursor.menu == 0x13) {
+        UpdateCutMovie();
+    }
+    if (level_part_2 == 0) {
+        UpdateLevel();
+        UpdateKabooms();
+        UpdateWumpa();
+        UpdateCrates();
+        UpdateMaskFeathers();
+        UpdateCrateExplosions();
+        UpdateChases();
+        UpdateProjectiles();
+        UpdateBugLight(player);
+        UpdateGameCut();
+    }
+    ProcessVehicleLevel(Pad[0]);
+}
+
+static void GameStageDebris(void) {
+    ProcDeb3();
+    if (NODEBRIS == 0) {
+        Debris(0);
+    }
+}
+
+static void GameStageDebrisHit(void) {
+    struct nuvec_s pos;
+
+    if ((NODEBRIS == 0) && ((GLASSPLAYER == 0) || !(5.0f > plr_invisibility_time))) {
+        pos.x = player->obj.pos.x;
+        pos.y = ((player->obj.bot + player->obj.top) * player->obj.SCALE) * 0.5f + player->obj.pos.y;
+        pos.z = player->obj.pos.z;
+        if (DebrisCollisionCheck(&pos,player->obj.RADIUS) != -1) {
+            KillPlayer(&player->obj,0x14);
+        }
+    }
+}
+
+static void GameStageTexAnim(void) {
+    NuMtlAnimate(0.01666667f);
+}
+
+static void GameStageCamera(void) {
+    UpdateTempCharacter();
+    UpdateAwards();
+    MoveGameCamera(GameCam,&player->obj);
+    UpdateScreenWumpas();
+    if (PLAYERCOUNT != 0) {
+        UpdatePlayerStats(player);
+    }
+    UpdatePanelDebris();
+}
+
+// The old platform and scene updates run before these, see GameStageScene. Editor objects and animations play sounds and
+// spawn debris, so they stay on the main thread like the creatures and debris do. Bridges and wind read the player
+// before creatures move it. Bridges sit between the two platform updates as they always have: they read the platform hit
+// flags and move the plank matrices the platforms point at. Texture animation only touches its own data.
+static struct nujobstage_s GameStages[] = {
+    { "Objects", GameStageObjects, 0, GSTAGE_SCENE | GSTAGE_DEBRIS, NUJOBSTAGE_MAINTHREAD },
+    { "Bridges", GameStageBridges, GSTAGE_SCENE | GSTAGE_CHARS, GSTAGE_BRIDGE, 0 },
+    { "PlatsNew", GameStagePlatsNew, GSTAGE_BRIDGE, GSTAGE_SCENE, 0 },
+    { "Wind", GameStageWind, GSTAGE_CHARS, GSTAGE_WIND, 0 },
+    { "TexAnim", GameStageTexAnim, 0, GSTAGE_MTL, 0 },
+    { "Chars", GameStageChars, GSTAGE_SCENE | GSTAGE_BRIDGE | GSTAGE_WIND, GSTAGE_CHARS | GSTAGE_LEVEL | GSTAGE_DEBRIS, NUJOBSTAGE_MAINTHREAD },
+    { "Update", GameStageUpdate, GSTAGE_SCENE, GSTAGE_CHARS | GSTAGE_LEVEL | GSTAGE_DEBRIS, NUJOBSTAGE_MAINTHREAD },
+    { "Debris", GameStageDebris, 0, GSTAGE_DEBRIS, NUJOBSTAGE_MAINTHREAD },
+    { "DebrisHit", GameStageDebrisHit, GSTAGE_DEBRIS, GSTAGE_CHARS, NUJOBSTAGE_MAINTHREAD },
+    { "Camera", GameStageCamera, GSTAGE_ALL, GSTAGE_CAM | GSTAGE_LEVEL, NUJOBSTAGE_MAINTHREAD },
+};
+#define GAMESTAGE_COUNT (sizeof(GameStages) / sizeof(GameStages[0]))
+
+static s32 gamestages_ready;
+static s32 gamestages_frames;
+
+// Runs one substep's update chain, with the timing report on the GameStepReport cadence.
+static void GameStagesRun(void) {
+    if (gamestages_ready == 0) {
+        NuJobStagesInit(GameStages, GAMESTAGE_COUNT);
+        gamestages_ready = 1;
+    }
+    GameStageScene();
+    NuJobRunStages(GameStages, GAMESTAGE_COUNT);
+    if ((GameStepReport != 0) && (++gamestages_frames >= GAMESTEP_HZ * 5)) {
+        NuJobStagesReport(GameStages, GAMESTAGE_COUNT);
+        gamestages_frames = 0;
+    }
+}
+
+
 //92.85% NGC (86% PS2)
 /*
 int main(s32 argc,char **argv) {
@@ -1237,6 +1412,7 @@ LAB_80051ba4:
   srand(0);
   qseed = 0x3039;
   NuRandSeed(0);
+  NuRngSeedAll(0);
   if (Level == 0x23) {
     NewGame();
     Hub = -1;
@@ -1356,6 +1532,7 @@ LAB_80051ba4:
   srand(0);
   qseed = 0x3039;
   NuRandSeed(0);
+  NuRngSeedAll(0);
   while( 1 ) {
     NuSoundSetLevelAmbience();
     NuSoundUpdate();
@@ -1407,6 +1584,7 @@ LAB_80051ba4:
     frameout_count = nuvideo_global_vbcnt;
     frameout = 0;
     NuInitFrameAdvance();
+    GameStepReset();
     while (((new_mode == -1 && (new_level == -1)) || ((fadeval < 0xff || (fadehack != 0))))) {
       DBTimerStart(1);
       tbslotBegin(app_tbset,0);
@@ -1429,31 +1607,17 @@ LAB_80051ba4:
         NuSoundSetLevelAmbience();
       }
       NuGetFrameAdvance();
-        FRAMES = 1;
+      plr = player;
+      FRAMES = GameStepBegin();
       if ((FixFrameRate != 0) || (pad_record != 0) || (pad_play != 0)) {
              FRAMES = 1;
       }
-      plr = player;
-      FRAMES = 1;
-      if ((s32)cufps < 59.0f) {
-        FRAMES = 2;
-      }
-      if (cufps < 29.0f) {
-        FRAMES++;
-      }
-      if (cufps < 19.0f) {
-        FRAMES++;
-      }
-      if (cufps < 14.0f) {
-        FRAMES = FRAMES + 1;
-      }
-      if (FRAMES == 0) {
-        FRAMES = 1;
-      }
       
       //bVar2 = local_9d != 0;
       //if (FRAMES != 0) {
         for (FRAME = 0; FRAME < FRAMES; FRAME++) {
+                  GameStepSubstepBegin();
+                  uVar5 = (FRAME == FRAMES - 1);
                   if (FRAME == 0) {
                     tbslotBegin(app_tbset,1);
                   }
@@ -1496,75 +1660,13 @@ LAB_80051ba4:
                         }
                         SetLevelLights();
                         SetTexAnimSignals();
-                        TBCODESTART(0,"Plats");
-                        if ((LDATA->flags & 8) != 0) {
-                          TerrainPlatformOldUpdate();
-                        }
-                        if (world_scene[0] != NULL) {
-                           NuGScnUpdate(world_scene[0],1.0f);
-                        }
-                        edobjUpdateObjects(1.0f);
-                        edanimUpdateObjects(1.0f);
-                        NuRndrWaterRippleUpdate(1);
-                        NuBridgeUpdate(&Character[0].obj.pos);
-                        NuWindUpdate(&Character[0].obj.pos);
-                        if ((LDATA->flags & 8) != 0) {
-                          TerrainPlatformNewUpdate();
-                        }
-                        TBCODEEND(0);
-                        TBCODESTART(1,"Chars");
-                        if ((LDATA->flags & 1) != 0) {
-                          if (FRAME == 0) {
-                            tbslotBegin(app_tbset,5);
-                          }
-                          ManageCreatures();
-                          ProcessCreatures();
-                          if (FRAME == 0) {
-                            tbslotEnd(app_tbset,5);
-                          }
-                        }
-                        TBCODEEND(1);
-                        TBCODESTART(2,"Update");
-                        if (Cursor.menu == 0x13) {
-                          UpdateCutMovie();
-                        }
-                        if (level_part_2 == 0) {
-                          UpdateLevel();
-                          UpdateKabooms();
-                          UpdateWumpa();
-                          UpdateCrates();
-                          UpdateMaskFeathers();
-                          UpdateCrateExplosions();
-                          UpdateChases();
-                          UpdateProjectiles();
-                          UpdateBugLight(plr);
-                          UpdateGameCut();
-                        }
-                        ProcessVehicleLevel(Pad[0]);
-                        TBCODESTART(3,"Deb");
-                        ProcDeb3();
-                        if ((NODEBRIS == 0) &&
-                           ((Debris(0), GLASSPLAYER == 0 || !(5.0f > plr_invisibility_time)))) {
-                          pos.x = player->obj.pos.x;
-                          pos.y = ((player->obj.bot + player->obj.top) * player->obj.SCALE) * 0.5f 
-                                          + player->obj.pos.y;
-                          pos.z = player->obj.pos.z;
-                          iVar9 = DebrisCollisionCheck(&pos,player->obj.RADIUS);
-                          if (iVar9 != -1) {
-                            KillPlayer(&player->obj,0x14);
-                          }
+                        if (FRAME == 0) {
+                          tbslotBegin(app_tbset,5);
                         }
-                        //GameCam_ = (CamMtx *)0x20000000;
-                        NuMtlAnimate(0.01666667f);
-                        TBCODEEND(3);
-                        UpdateTempCharacter();
-                        UpdateAwards();
-                        MoveGameCamera(GameCam,&plr->obj);
-                        UpdateScreenWumpas();
-                        if (PLAYERCOUNT != 0) {
-                          UpdatePlayerStats(plr);
+                        GameStagesRun();
+                        if (FRAME == 0) {
+                          tbslotEnd(app_tbset,5);
                         }
-                        UpdatePanelDebris();
                   }
                   if ((FRAME == FRAMES - 1) && (pause_rndr_on == 0)) {
                     AddBugLight(plr);
@@ -1595,6 +1697,7 @@ LAB_80051ba4:
                   }
                   if (pause_rndr_on == 0) {
                     if (FRAME == FRAMES - 1) {
+                      GameStepInterpolate();
                       tbslotBegin(app_tbset,9);
                       GS_Parallax = 1;
                       pCam = GameCam;
@@ -1662,6 +1765,7 @@ LAB_80051ba4:
                       DrawTempCharacter2(uVar5);
                     }
                   }
+                  GameStepSubstepEnd();
                   //FRAME = FRAME + 1;
         } //while (FRAME < FRAMES);
       //}
@@ -1843,6 +1947,7 @@ LAB_80051ba4:
       }
       DBTimerEnd(3);
       DBTimerEnd(1);
+      GameStepRestore();
       NuRndrSwapScreen(1);
       NuDynamicWaterUpdate(0);
       Reseter(0);
@@ -276,6 +276,31 @@ struct nulsthdr_s
     short elsize; // Offset: 0xE, DWARF: 0x1464C3
 };
 
+// Packed alternative to the NuLst lists: live elements sit at the front of data so walking them is a
+// linear scan. Freeing moves the last element into the hole, so hold a handle ((gen << 16) | index)
+// rather than a pointer across a free.
+struct nupool_s
+{
+    u8* data;
+    u16* slotof;        // handle index -> element position
+    u16* handleof;      // element position -> handle index
+    u16* gen;
+    u16* freenext;
+    volatile s32 freehead; // (tag << 16) | (handle index + 1), 0 when empty
+    volatile s32 count;
+    s32 elcnt;
+    s32 elsize;
+};
+
+struct nupool_s* NuPoolCreate(s32 elcnt, s32 elsize);
+void NuPoolDestroy(struct nupool_s* pool);
+void* NuPoolAlloc(struct nupool_s* pool);
+void* NuPoolAllocConcurrent(struct nupool_s* pool);
+void NuPoolFree(struct nupool_s* pool, void* el);
+void* NuPoolGetNext(struct nupool_s* pool, void* el);
+u32 NuPoolHandle(struct nupool_s* pool, void* el);
+void* NuPoolGet(struct nupool_s* pool, u32 handle);
+
 
 
 #endif // !MAIN_H
@@ -26,7 +26,251 @@ static s32 PtInsideSpline(struct nuvec_s *wpos,struct nugspline_s *sp) {
   return n & 1;
 }
 
-//NGC MATCH
+// Vis spline grid, built by BuildVisiTable.
+// Each XZ cell holds two spline bitsets: splines that fully contain the cell and splines whose edge crosses it.
+// Only the edge splines need PtInsideSpline at run time, and instances are only touched when the set changes.
+#define VISIGRIDMAX 64
+#define VISISPLINEMAX 256
+
+static struct nugscn_s* vgscn;
+static u32* vgcells;
+static u32* vgsplset;
+static u32* vginstset[2];
+static s32 vgcur;
+static s32 vgwords;
+static s32 vginstwords;
+static s32 vgnx;
+static s32 vgnz;
+static float vgx;
+static float vgz;
+static float vgcellsize;
+static s32 vgvalid;
+
+static s32 VSEdgeHitsCell(struct nuvec_s* a, struct nuvec_s* b, float x0, float z0, float x1, float z1) {
+    float t0;
+    float t1;
+    float p[4];
+    float q[4];
+    float r;
+    s32 i;
+
+    t0 = 0.0f;
+    t1 = 1.0f;
+    p[0] = -(b->x - a->x);
+    q[0] = a->x - x0;
+    p[1] = b->x - a->x;
+    q[1] = x1 - a->x;
+    p[2] = -(b->z - a->z);
+    q[2] = a->z - z0;
+    p[3] = b->z - a->z;
+    q[3] = z1 - a->z;
+    for (i = 0; i < 4; i++) {
+        if (p[i] == 0.0f) {
+            if (q[i] < 0.0f) {
+                return 0;
+            }
+        }
+        else {
+            r = q[i] / p[i];
+            if (p[i] < 0.0f) {
+                if (r > t1) {
+                    return 0;
+                }
+                if (r > t0) {
+                    t0 = r;
+                }
+            }
+            else {
+                if (r < t0) {
+                    return 0;
+                }
+                if (r < t1) {
+                    t1 = r;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+static void VSBuildGrid(struct nugscn_s* gsc) {
+    struct nuvec_s* pts;
+    struct nuvec_s* prev;
+    struct nugspline_s* sp;
+    float minx;
+    float minz;
+    float maxx;
+    float maxz;
+    float x0;
+    float z0;
+    u32* cell;
+    s32 size;
+    s32 edge;
+    s32 cx;
+    s32 cz;
+    s32 m;
+    s32 n;
+
+    vgscn = gsc;
+    vgcells = NULL;
+    vgvalid = 0;
+    if ((vscnt == 0) || (vscnt > VISISPLINEMAX)) {
+        return;
+    }
+
+    minx = minz = 1e30f;
+    maxx = maxz = -1e30f;
+    for (m = 0; m < vscnt; m++) {
+        sp = visidat[m]->sp;
+        pts = (struct nuvec_s*)sp->pts;
+        for (n = 0; n < sp->len; n++) {
+            minx = (pts[n].x < minx) ? pts[n].x : minx;
+            maxx = (pts[n].x > maxx) ? pts[n].x : maxx;
+            minz = (pts[n].z < minz) ? pts[n].z : minz;
+            maxz = (pts[n].z > maxz) ? pts[n].z : maxz;
+        }
+    }
+    vgcellsize = (((maxx - minx) > (maxz - minz)) ? (maxx - minx) : (maxz - minz)) / VISIGRIDMAX;
+    if (vgcellsize < 1.0f) {
+        vgcellsize = 1.0f;
+    }
+    vgx = minx;
+    vgz = minz;
+    vgnx = (s32)((maxx - minx) / vgcellsize) + 1;
+    vgnz = (s32)((maxz - minz) / vgcellsize) + 1;
+    vgnx = (vgnx > VISIGRIDMAX) ? VISIGRIDMAX : vgnx;
+    vgnz = (vgnz > VISIGRIDMAX) ? VISIGRIDMAX : vgnz;
+    vgwords = (vscnt + 31) >> 5;
+    vginstwords = (gsc->numinstance + 31) >> 5;
+
+    size = (vgnx * vgnz * vgwords * 2 + vgwords + vginstwords * 2) * sizeof(u32);
+    vgcells = (u32*)NuMemAlloc(size);
+    if (vgcells == NULL) {
+        return;
+    }
+    memset(vgcells, 0, size);
+    vgsplset = &vgcells[vgnx * vgnz * vgwords * 2];
+    vginstset[0] = &vgsplset[vgwords];
+    vginstset[1] = &vginstset[0][vginstwords];
+    vgcur = 0;
+
+    for (cz = 0; cz < vgnz; cz++) {
+        for (cx = 0; cx < vgnx; cx++) {
+            cell = &vgcells[(cz * vgnx + cx) * vgwords * 2];
+            x0 = vgx + cx * vgcellsize;
+            z0 = vgz + cz * vgcellsize;
+            for (m = 0; m < vscnt; m++) {
+                sp = visidat[m]->sp;
+                pts = (struct nuvec_s*)sp->pts;
+                prev = &pts[sp->len - 1];
+                for (edge = 0, n = 0; n < sp->len; n++) {
+                    if (VSEdgeHitsCell(prev, &pts[n], x0, z0, x0 + vgcellsize, z0 + vgcellsize) != 0) {
+                        edge = 1;
+                        break;
+                    }
+                    prev = &pts[n];
+                }
+                if (edge != 0) {
+                    cell[vgwords + (m >> 5)] |= (u32)1 << (m & 0x1f);
+                }
+                else {
+                    // no edge crosses the cell, its centre is inside or outside for all of it
+                    struct nuvec_s wpos;
+
+                    wpos.x = x0 + vgcellsize * 0.5f;
+                    wpos.y = 0.0f;
+                    wpos.z = z0 + vgcellsize * 0.5f;
+                    if (PtInsideSpline(&wpos, sp) != 0) {
+                        cell[m >> 5] |= (u32)1 << (m & 0x1f);
+                    }
+                }
+            }
+        }
+    }
+    return;
+}
+
+// Work out which vis splines contain pos, using the grid cell and testing only the splines crossing it.
+static void VSGridSplines(struct nuvec_s* pos, u32* set) {
+    u32* cell;
+    u32 bits;
+    s32 cx;
+    s32 cz;
+    s32 m;
+    s32 w;
+
+    memset(set, 0, vgwords * sizeof(u32));
+    cx = (s32)floor((pos->x - vgx) / vgcellsize);
+    cz = (s32)floor((pos->z - vgz) / vgcellsize);
+    if ((cx < 0) || (cx >= vgnx) || (cz < 0) || (cz >= vgnz)) {
+        return;
+    }
+    cell = &vgcells[(cz * vgnx + cx) * vgwords * 2];
+    for (w = 0; w < vgwords; w++) {
+        set[w] = cell[w];
+        for (bits = cell[vgwords + w]; bits != 0; bits &= bits - 1) {
+            m = w * 32;
+            while (((bits >> (m & 0x1f)) & 1) == 0) {
+                m++;
+            }
+            if (PtInsideSpline(pos, visidat[m]->sp) != 0) {
+                set[w] |= (u32)1 << (m & 0x1f);
+            }
+        }
+    }
+    return;
+}
+
+// Apply the table through the grid. Only instances whose visibility changed since the last call are written.
+static void ApplyVisiGrid(struct nugscn_s* sc, struct nuvec_s* pos) {
+    u32 newset[VISISPLINEMAX >> 5];
+    u32* cur;
+    u32* prev;
+    u32 diff;
+    struct visidat_s* vd;
+    s32 same;
+    s32 m;
+    s32 n;
+    s32 w;
+
+    VSGridSplines(pos, newset);
+    same = 1;
+    for (w = 0; w < vgwords; w++) {
+        if (newset[w] != vgsplset[w]) {
+            same = 0;
+        }
+    }
+    if ((same != 0) && (vgvalid != 0)) {
+        return;
+    }
+    memcpy(vgsplset, newset, vgwords * sizeof(u32));
+
+    prev = vginstset[vgcur];
+    vgcur ^= 1;
+    cur = vginstset[vgcur];
+    memset(cur, 0, vginstwords * sizeof(u32));
+    for (m = 0; m < vscnt; m++) {
+        if ((newset[m >> 5] >> (m & 0x1f)) & 1) {
+            vd = visidat[m];
+            for (n = 0; n < vd->numinstances; n++) {
+                w = vd->i[n] - sc->instances;
+                cur[w >> 5] |= (u32)1 << (w & 0x1f);
+            }
+        }
+    }
+
+    for (w = 0; w < vginstwords; w++) {
+        diff = (vgvalid != 0) ? (cur[w] ^ prev[w]) : 0xffffffff;
+        for (n = w * 32; (diff != 0) && (n < sc->numinstance); n++, diff >>= 1) {
+            if (diff & 1) {
+                sc->instances[n].flags.visitest = (cur[w] >> (n & 0x1f)) & 1;
+            }
+        }
+    }
+    vgvalid = 1;
+    return;
+}
+
 void ApplyVisiTable(struct nugscn_s *sc,struct nuvec_s *pos) {
   s32 n;
   s32 m;
@@ -37,6 +281,10 @@ void ApplyVisiTable(struct nugscn_s *sc,struct nuvec_s *pos) {
         for (m = 0, n = 0; m < sc->numinstance; m++, n++) {
           sc->instances[n].flags.visitest = 0x20000000 | 1;
         }
+        vgvalid = 0;
+    }
+    else if ((vgcells != NULL) && (sc == vgscn)) {
+        ApplyVisiGrid(sc,pos);
     }
     else {
         for (m = 0, n = 0; m < sc->numinstance; m++, n++) {
@@ -82,7 +330,6 @@ static s32 VSAddObjs(struct nuinstance_s** op, struct nugscn_s* gsc, struct nugs
     return icnt;
 }
 
-//NGC MATCH
 void BuildVisiTable(struct nugscn_s *gsc) {
   s32 n;
   s32 ocnt;
@@ -115,14 +362,19 @@ void BuildVisiTable(struct nugscn_s *gsc) {
                   (char*)vd +=  (s32)ptr;
                 }
             }
-            
+            VSBuildGrid(gsc);
        }
   }
   return;
 }
 
-//NGC MATCH
 void ReleaseVisiTable(void) {
+    if (vgcells != NULL) {
+        NuMemFree(vgcells);
+    }
+    vgcells = NULL;
+    vgscn = NULL;
+    vgvalid = 0;
     if (vsdata != NULL) {
         NuMemFree(vsdata);
     }
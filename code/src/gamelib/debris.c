@@ -2,6 +2,17 @@
 
 #define RAND_MAX (2147483647)
 
+// Debris draws from its own stream. Editor objects and creatures spawn debris from the Objects and Chars stages, which
+// like every other game stage that reaches here are main thread only, so the stream is never drawn from two threads.
+static inline s32 DebRandy(void) {
+    return NuRngU32(NuRngStream(NURNG_DEBRIS)) >> 1;
+}
+
+// n DebRandy() values at once, as floats.
+static inline void DebRandyFill(float* r, s32 n) {
+    NuRngFillFloat(NuRngStream(NURNG_DEBRIS), r, n, 0.0f, 2147483648.0f);
+}
+
 //NGC MATCH
 s32 SolveQuadratic(float a, float b, float c, float* t1, float* t2) {
     float x;
@@ -30,9 +41,9 @@ s32 SolveQuadratic(float a, float b, float c, float* t1, float* t2) {
     }
 }
 
-//NGC MATCH
 struct uv1deb* GenDebIndex(struct debkeydatatype_s* current_deb_key, struct debinftype* debinfo) {
     struct uv1deb* deb;
+    float r[6];
     struct nuvec_s emit;
 
     if ((current_deb_key->pointer) >= (current_deb_key->debcount)) {
@@ -42,16 +53,17 @@ struct uv1deb* GenDebIndex(struct debkeydatatype_s* current_deb_key, struct debi
     deb = deb + (current_deb_key->pointer++ % 0x20);
     deb->time = globaltime;
     deb->etime = 64.0f / debinfo->etime;
-    emit.x = (float)(randy()) * (debinfo->variable_start_ranscale).x - (debinfo->variable_start).x;
-    emit.y = (float)randy() * (debinfo->variable_start_ranscale).y - (debinfo->variable_start).y;
-    emit.z = (float)randy() * (debinfo->variable_start_ranscale).z - (debinfo->variable_start).z;
+    DebRandyFill(r, 6);
+    emit.x = r[0] * (debinfo->variable_start_ranscale).x - (debinfo->variable_start).x;
+    emit.y = r[1] * (debinfo->variable_start_ranscale).y - (debinfo->variable_start).y;
+    emit.z = r[2] * (debinfo->variable_start_ranscale).z - (debinfo->variable_start).z;
     NuVecMtxTransform(&emit, &emit, &current_deb_key->emitrotmtx);
     deb->x = emit.x;
     deb->y = emit.y;
     deb->z = emit.z;
-    emit.x = (float)randy() * (debinfo->variable_emit_ranscale).x - (debinfo->variable_emit).x;
-    emit.y = ((float)randy() * (debinfo->variable_emit_ranscale).y - (debinfo->variable_emit).y) + debinfo->emitmag;
-    emit.z = randy() * (debinfo->variable_emit_ranscale).z - (debinfo->variable_emit).z;
+    emit.x = r[3] * (debinfo->variable_emit_ranscale).x - (debinfo->variable_emit).x;
+    emit.y = (r[4] * (debinfo->variable_emit_ranscale).y - (debinfo->variable_emit).y) + debinfo->emitmag;
+    emit.z = r[5] * (debinfo->variable_emit_ranscale).z - (debinfo->variable_emit).z;
     NuVecMtxTransform(&emit, &emit, &current_deb_key->emitrotmtx);
     deb->mx = emit.x;
     deb->my = emit.y;
@@ -68,7 +80,6 @@ struct uv1deb* GenDebIndex(struct debkeydatatype_s* current_deb_key, struct debi
     return deb;
 }
 
-//NGC MATCH
 inline struct uv1deb* GenDebIndexRadial(struct debkeydatatype_s* current_deb_key, struct debinftype* debinfo) {
     struct uv1deb* deb;
     s32 ry;
@@ -82,8 +93,8 @@ inline struct uv1deb* GenDebIndexRadial(struct debkeydatatype_s* current_deb_key
     deb = deb + (current_deb_key->pointer++ % 0x20);
     deb->time = globaltime;
     deb->etime = 64.0f / debinfo->etime;
-    ry = (randy() * (debinfo->variable_emit_ranscale).y - (debinfo->variable_emit).y) + (debinfo->variable_start).y;
-    rz = (randy() * (debinfo->variable_emit_ranscale).z - (debinfo->variable_emit).z) + (debinfo->variable_start).z;
+    ry = (DebRandy() * (debinfo->variable_emit_ranscale).y - (debinfo->variable_emit).y) + (debinfo->variable_start).y;
+    rz = (DebRandy() * (debinfo->variable_emit_ranscale).z - (debinfo->variable_emit).z) + (debinfo->variable_start).z;
     emit.y = (debinfo->variable_start).x;
     emit.x = emit.z = 0.0f;
     NuVecRotateZ(&emit, &emit, rz);
@@ -92,7 +103,7 @@ inline struct uv1deb* GenDebIndexRadial(struct debkeydatatype_s* current_deb_key
     deb->x = emit.x;
     deb->y = emit.y;
     deb->z = emit.z;
-    emit.y = (randy() * (debinfo->variable_emit_ranscale).x - (debinfo->variable_emit).x) + debinfo->emitmag;
+    emit.y = (DebRandy() * (debinfo->variable_emit_ranscale).x - (debinfo->variable_emit).x) + debinfo->emitmag;
     emit.x = emit.z = 0.0f;
     NuVecRotateZ(&emit, &emit, rz);
     NuVecRotateY(&emit, &emit, ry);
@@ -112,7 +123,6 @@ inline struct uv1deb* GenDebIndexRadial(struct debkeydatatype_s* current_deb_key
     return deb;
 }
 
-//NGC MATCH
 inline struct uv1deb* GenDebIndexRadialRotor(struct debkeydatatype_s* current_deb_key, struct debinftype* debinfo) {
     struct uv1deb* deb;
     s32 rz;
@@ -137,7 +147,7 @@ inline struct uv1deb* GenDebIndexRadialRotor(struct debkeydatatype_s* current_de
     deb->y = local_60.y;
     deb->z = local_60.z;
     local_60.y =
-        ((float)(randy()) * (debinfo->variable_emit_ranscale).x - (debinfo->variable_emit).x) + debinfo->emitmag;
+        ((float)(DebRandy()) * (debinfo->variable_emit_ranscale).x - (debinfo->variable_emit).x) + debinfo->emitmag;
     local_60.x = local_60.z = 0.0f;
     NuVecRotateZ(&local_60, &local_60, rz);
     NuVecRotateY(&local_60, &local_60, ry);
@@ -167,7 +177,6 @@ inline struct uv1deb* GenDebIndexRadialRotor(struct debkeydatatype_s* current_de
     return deb;
 }
 
-//NGC MATCH
 inline struct uv1deb* GenDebIndexSpheroid(struct debkeydatatype_s* current_deb_key, struct debinftype* debinfo) {
     struct uv1deb* deb;
     s32 ry;
@@ -182,10 +191,10 @@ inline struct uv1deb* GenDebIndexSpheroid(struct debkeydatatype_s* current_deb_k
     deb = deb + (current_deb_key->pointer++ % 0x20);
     deb->time = globaltime;
     deb->etime = 64.0f / debinfo->etime;
-    emit.y = (float)(randy() * 1.0/(RAND_MAX + 1.0)); // 3e 00 00 00 00 00 00 00
+    emit.y = (float)(DebRandy() * 1.0/(RAND_MAX + 1.0)); // 3e 00 00 00 00 00 00 00
     emit.x = emit.z = 0.0f;
-    ry = (s32)(randy() * 0.0000152587890625);
-    rz = (s32)(randy() * 0.000030517578125);
+    ry = (s32)(DebRandy() * 0.0000152587890625);
+    rz = (s32)(DebRandy() * 0.000030517578125);
     NuVecRotateZ(&emit, &emit, rz);
     NuVecRotateY(&emit, &emit, ry);
     NuMtxSetIdentity(&sscale);
@@ -197,9 +206,9 @@ inline struct uv1deb* GenDebIndexSpheroid(struct debkeydatatype_s* current_deb_k
     deb->x = emit.x;
     deb->y = emit.y;
     deb->z = emit.z;
-    emit.x = randy() * (debinfo->variable_emit_ranscale).x - (debinfo->variable_emit).x;
-    emit.y = (randy() * (debinfo->variable_emit_ranscale).y - (debinfo->variable_emit).y) + debinfo->emitmag;
-    emit.z = (float)randy() * (debinfo->variable_emit_ranscale).z - (debinfo->variable_emit).z;
+    emit.x = DebRandy() * (debinfo->variable_emit_ranscale).x - (debinfo->variable_emit).x;
+    emit.y = (DebRandy() * (debinfo->variable_emit_ranscale).y - (debinfo->variable_emit).y) + debinfo->emitmag;
+    emit.z = (float)DebRandy() * (debinfo->variable_emit_ranscale).z - (debinfo->variable_emit).z;
     NuVecMtxTransform(&emit, &emit, &current_deb_key->emitrotmtx);
     deb->mx = emit.x;
     deb->my = emit.y;
@@ -216,9 +225,9 @@ inline struct uv1deb* GenDebIndexSpheroid(struct debkeydatatype_s* current_deb_k
     return deb;
 }
 
-//NGC MATCH
 inline struct uv1deb* GenDebIndexBounceY(struct debkeydatatype_s* current_deb_key, struct debinftype* debinfo) {
     struct uv1deb* deb;
+    float r[6];
     struct rdata_s* chunk;
     struct nuvec_s emit;
     float quad1;
@@ -231,16 +240,17 @@ inline struct uv1deb* GenDebIndexBounceY(struct debkeydatatype_s* current_deb_ke
     deb = &chunk->debris[current_deb_key->pointer % 0x20];
     deb->time = globaltime;
     deb->etime = 64.0f / debinfo->etime;
-    emit.x = (float)randy() * (debinfo->variable_start_ranscale).x - (debinfo->variable_start).x;
-    emit.y = (float)randy() * (debinfo->variable_start_ranscale).y - (debinfo->variable_start).y;
-    emit.z = (float)randy() * (debinfo->variable_start_ranscale).z - (debinfo->variable_start).z;
+    DebRandyFill(r, 6);
+    emit.x = r[0] * (debinfo->variable_start_ranscale).x - (debinfo->variable_start).x;
+    emit.y = r[1] * (debinfo->variable_start_ranscale).y - (debinfo->variable_start).y;
+    emit.z = r[2] * (debinfo->variable_start_ranscale).z - (debinfo->variable_start).z;
     NuVecMtxTransform(&emit, &emit, &current_deb_key->emitrotmtx);
     deb->x = emit.x;
     deb->y = emit.y;
     deb->z = emit.z;
-    emit.x = (float)randy() * (debinfo->variable_emit_ranscale).x - (debinfo->variable_emit).x;
-    emit.y = ((float)randy() * (debinfo->variable_emit_ranscale).y - (debinfo->variable_emit).y) + debinfo->emitmag;
-    emit.z = (float)randy() * (debinfo->variable_emit_ranscale).z - (debinfo->variable_emit).z;
+    emit.x = r[3] * (debinfo->variable_emit_ranscale).x - (debinfo->variable_emit).x;
+    emit.y = (r[4] * (debinfo->variable_emit_ranscale).y - (debinfo->variable_emit).y) + debinfo->emitmag;
+    emit.z = r[5] * (debinfo->variable_emit_ranscale).z - (debinfo->variable_emit).z;
     NuVecMtxTransform(&emit, &emit, &current_deb_key->emitrotmtx);
     deb->mx = emit.x;
     deb->my = emit.y;
@@ -286,9 +296,9 @@ inline struct uv1deb* GenDebIndexBounceY(struct debkeydatatype_s* current_deb_ke
 
 struct nuvec_s lbl_80119E30 = {1.0f, 0.0f, 0.0f};
 
-//NGC MATCH
 inline struct uv1deb* GenDebIndexBounceXZ(struct debkeydatatype_s* current_deb_key, struct debinftype* debinfo) {
     struct uv1deb* deb;
+    float r[6];
     struct rdata_s* chunk;
     struct nuvec_s emit;
     struct nuvec_s normal;
@@ -308,16 +318,17 @@ inline struct uv1deb* GenDebIndexBounceXZ(struct debkeydatatype_s* current_deb_k
     deb = &chunk->debris[current_deb_key->pointer % 0x20];
     deb->time = globaltime;
     deb->etime = 64.0f / debinfo->etime;
-    emit.x = (float)randy() * (debinfo->variable_start_ranscale).x - (debinfo->variable_start).x;
-    emit.y = (float)randy() * (debinfo->variable_start_ranscale).y - (debinfo->variable_start).y;
-    emit.z = (float)randy() * (debinfo->variable_start_ranscale).z - (debinfo->variable_start).z;
+    DebRandyFill(r, 6);
+    emit.x = r[0] * (debinfo->variable_start_ranscale).x - (debinfo->variable_start).x;
+    emit.y = r[1] * (debinfo->variable_start_ranscale).y - (debinfo->variable_start).y;
+    emit.z = r[2] * (debinfo->variable_start_ranscale).z - (debinfo->variable_start).z;
     NuVecMtxTransform(&emit, &emit, &current_deb_key->emitrotmtx);
     deb->x = emit.x;
     deb->y = emit.y;
     deb->z = emit.z;
-    emit.x = (float)randy() * (debinfo->variable_emit_ranscale).x - (debinfo->variable_emit).x;
-    emit.y = ((float)randy() * (debinfo->variable_emit_ranscale).y - (debinfo->variable_emit).y) + debinfo->emitmag;
-    emit.z = (float)randy() * (debinfo->variable_emit_ranscale).z - (debinfo->variable_emit).z;
+    emit.x = r[3] * (debinfo->variable_emit_ranscale).x - (debinfo->variable_emit).x;
+    emit.y = (r[4] * (debinfo->variable_emit_ranscale).y - (debinfo->variable_emit).y) + debinfo->emitmag;
+    emit.z = r[5] * (debinfo->variable_emit_ranscale).z - (debinfo->variable_emit).z;
     NuVecMtxTransform(&emit, &emit, &current_deb_key->emitrotmtx);
     deb->mx = emit.x;
     deb->my = emit.y;
@@ -367,6 +378,7 @@ inline struct uv1deb* GenDebIndexBounceXZ(struct debkeydatatype_s* current_deb_k
 inline struct uv1deb*
 GenDebIndexPos(struct debkeydatatype_s* current_deb_key, struct debinftype* debinfo, struct nuvec_s* pos) {
     struct uv1deb* deb;
+    float r[6];
 
     if (current_deb_key->pointer >= current_deb_key->debcount) {
         current_deb_key->pointer = 0;
@@ -375,12 +387,13 @@ GenDebIndexPos(struct debkeydatatype_s* current_deb_key, struct debinftype* debi
     deb = deb + (current_deb_key->pointer++ % 0x20);
     deb->time = globaltime;
     deb->etime = 64.0f / debinfo->etime;
-    deb->x = (float)randy() * debinfo->rsx + debinfo->osx;
-    deb->y = (float)randy() * debinfo->rsy + debinfo->osy;
-    deb->z = (float)randy() * debinfo->rsz + debinfo->osz;
-    deb->mx = (float)randy() * debinfo->rvx + debinfo->ovx;
-    deb->my = (float)randy() * debinfo->rvy + debinfo->ovy;
-    deb->mz = (float)randy() * debinfo->rvz + debinfo->ovz;
+    DebRandyFill(r, 6);
+    deb->x = r[0] * debinfo->rsx + debinfo->osx;
+    deb->y = r[1] * debinfo->rsy + debinfo->osy;
+    deb->z = r[2] * debinfo->rsz + debinfo->osz;
+    deb->mx = r[3] * debinfo->rvx + debinfo->ovx;
+    deb->my = r[4] * debinfo->rvy + debinfo->ovy;
+    deb->mz = r[5] * debinfo->rvz + debinfo->ovz;
     if (current_deb_key->genptr != NULL) {
         (current_deb_key->genptr)(current_deb_key, debinfo, deb);
     }
@@ -400,6 +413,7 @@ inline void GenDebIndexSort(struct debkeydatatype_s* current_deb_key, struct deb
 inline struct uv1deb*
 GenDebIndexPosRandTime(struct debkeydatatype_s* current_deb_key, struct debinftype* debinfo, struct nuvec_s* pos) {
     struct uv1deb* deb;
+    float r[6];
 
     if (current_deb_key->pointer >= current_deb_key->debcount) {
         current_deb_key->pointer = 0;
@@ -407,13 +421,14 @@ GenDebIndexPosRandTime(struct debkeydatatype_s* current_deb_key, struct debinfty
     deb = current_deb_key->chunks[current_deb_key->pointer / 0x20]->debris;
     deb = deb + (current_deb_key->pointer++ % 0x20);
     deb->time = globaltime;
-    deb->etime = 64.0f / (debinfo->etime + (debinfo->etime * randy()) / 1.503239e+09f);
-    deb->x = (float)randy() * debinfo->rsx + debinfo->osx;
-    deb->y = (float)randy() * debinfo->rsy + debinfo->osy;
-    deb->z = (float)randy() * debinfo->rsz + debinfo->osz;
-    deb->mx = (float)randy() * debinfo->rvx + debinfo->ovx;
-    deb->my = (float)randy() * debinfo->rvy + debinfo->ovy;
-    deb->mz = (float)randy() * debinfo->rvz + debinfo->ovz;
+    deb->etime = 64.0f / (debinfo->etime + (debinfo->etime * DebRandy()) / 1.503239e+09f);
+    DebRandyFill(r, 6);
+    deb->x = r[0] * debinfo->rsx + debinfo->osx;
+    deb->y = r[1] * debinfo->rsy + debinfo->osy;
+    deb->z = r[2] * debinfo->rsz + debinfo->osz;
+    deb->mx = r[3] * debinfo->rvx + debinfo->ovx;
+    deb->my = r[4] * debinfo->rvy + debinfo->ovy;
+    deb->mz = r[5] * debinfo->rvz + debinfo->ovz;
     if (current_deb_key->genptr != NULL) {
         (current_deb_key->genptr)(current_deb_key, debinfo, deb);
     }
@@ -423,7 +438,6 @@ GenDebIndexPosRandTime(struct debkeydatatype_s* current_deb_key, struct debinfty
     return deb;
 }
 
-//NGC MATCH
 inline struct uv1deb* GenDebIndexWaterFall(struct debkeydatatype_s* current_deb_key, struct debinftype* debinfo) {
     float dist;
     struct uv1deb* deb;
@@ -435,14 +449,14 @@ inline struct uv1deb* GenDebIndexWaterFall(struct debkeydatatype_s* current_deb_
     deb = deb + (current_deb_key->pointer++ % 0x20);
     deb->time = globaltime;
     deb->etime = 64.0f / debinfo->etime;
-    dist = (randy() * 0.6 * (1.0/(RAND_MAX+1.0))) - 0.3f; //4.656612873077393e-10
+    dist = (DebRandy() * 0.6 * (1.0/(RAND_MAX+1.0))) - 0.3f; //4.656612873077393e-10
     deb->x = dist * NuTrigTable[14000];
     deb->z = dist * NuTrigTable[30384];
-    dist = 1.0 + (randy() * 1.5 * (1.0/(RAND_MAX+1.0))); //4.656612873077393e-10
+    dist = 1.0 + (DebRandy() * 1.5 * (1.0/(RAND_MAX+1.0))); //4.656612873077393e-10
     deb->mx = deb->x * 1.5f + dist * NuTrigTable[30000];
     deb->mz = deb->z * 1.5f + dist * NuTrigTable[46384];
-    deb->y = (float)randy() * debinfo->rsy + debinfo->osy;
-    deb->my = (float)randy() * debinfo->rvy + debinfo->ovy;
+    deb->y = (float)DebRandy() * debinfo->rsy + debinfo->osy;
+    deb->my = (float)DebRandy() * debinfo->rvy + debinfo->ovy;
     if (current_deb_key->genptr != NULL) {
         (current_deb_key->genptr)(current_deb_key, debinfo, deb);
     }
@@ -452,7 +466,6 @@ inline struct uv1deb* GenDebIndexWaterFall(struct debkeydatatype_s* current_deb_
     return deb;
 }
 
-//NGC MATCH
 inline struct uv1deb* GenDebIndexWaterFallSplash(struct debkeydatatype_s* current_deb_key, struct debinftype* debinfo) {
     struct uv1deb* deb;
     float x, y, z;
@@ -464,13 +477,13 @@ inline struct uv1deb* GenDebIndexWaterFallSplash(struct debkeydatatype_s* curren
     deb = deb + (current_deb_key->pointer++ % 0x20);
     deb->time = globaltime;
     deb->etime = 64.0f / debinfo->etime;
-    x = randy() * (0.9-0.7)*(1/(RAND_MAX+1.0)) + 0.7; // random(0.7, 0.9)  //4.656612873077393e-10
-    y = randy() * ((49152.0-16384.0)*(1/(RAND_MAX+1.0))) + 16384.0; // random(16384.0, 49152.0) //1.52587890625e-05
-    z = randy() * (2.5 - 1.0) * (1.0/(RAND_MAX+1.0)) + 1.0; // random(1.0, 1.5) //4.656612873077393e-10
+    x = DebRandy() * (0.9-0.7)*(1/(RAND_MAX+1.0)) + 0.7; // random(0.7, 0.9)  //4.656612873077393e-10
+    y = DebRandy() * ((49152.0-16384.0)*(1/(RAND_MAX+1.0))) + 16384.0; // random(16384.0, 49152.0) //1.52587890625e-05
+    z = DebRandy() * (2.5 - 1.0) * (1.0/(RAND_MAX+1.0)) + 1.0; // random(1.0, 1.5) //4.656612873077393e-10
     deb->mx = deb->x * 2;
     deb->mz = deb->z * 2;
-    deb->y = (randy()* debinfo->rsy) + debinfo->osy;
-    deb->my = (randy() * debinfo->rvy) + debinfo->ovy;
+    deb->y = (DebRandy()* debinfo->rsy) + debinfo->osy;
+    deb->my = (DebRandy() * debinfo->rvy) + debinfo->ovy;
     if (current_deb_key->genptr != NULL) {
         (current_deb_key->genptr)(current_deb_key, debinfo, deb);
     }
@@ -527,7 +540,7 @@ GenDebMomAdjFromPosRevTree(struct debkeydatatype_s* current_deb_key, struct debi
     deb->mx += deb->x * -0.6f;
     deb->mz += deb->z * -0.6f;
     deb->y -= (float)(sqrt(deb->x * deb->x + deb->z * deb->z) * 0.4);
-    deb->etime = 64.0f / (debinfo->etime + (debinfo->etime * randy()) / 1.503239e+09f); //1.503239e+09f
+    deb->etime = 64.0f / (debinfo->etime + (debinfo->etime * DebRandy()) / 1.503239e+09f); //1.503239e+09f
     return;
 }
 
@@ -1224,7 +1237,6 @@ void AddVariableShotDebrisEffect(s32 type,struct nuvec_s *pos,s32 numdeb,short e
   return;
 }
 
-//NGC MATCH
 void AddDebrisEffect(s32 *key,s32 type,float x,float y,float z) {
   s32 i;
   struct debinftype *debinfo;
@@ -1240,7 +1252,7 @@ void AddDebrisEffect(s32 *key,s32 type,float x,float y,float z) {
     debkeydata[*key].type = (short)type;
     debkeydata[*key].active = 1;
     DebrisStartOffset(*key,(s32)debinfo->ival_offset);
-    debkeydata[*key].oncount = debtab[type]->ival_on + (s32)((randy() * debtab[type]->ival_on_ran) * 0.125); //4.656612873077393e-10 --> asm (lfd)
+    debkeydata[*key].oncount = debtab[type]->ival_on + (s32)((DebRandy() * debtab[type]->ival_on_ran) * 0.125); //4.656612873077393e-10 --> asm (lfd)
     debkeydata[*key].genptr = gensorttab[debinfo->gensort];
     debkeydata[*key].gencode = gencodetab[debinfo->gencode];
     debkeydata[*key].rotory = 0;
@@ -1576,9 +1588,9 @@ void Debris(s32 pause) {
             if (current_deb_key->oncount == 0) {
                 // inline (?)
                 double _yy;
-                _yy = randy();
+                _yy = DebRandy();
                 current_deb_key->delay += debinfo->ival_off + (s32)((float)debinfo->ival_off_ran * 0.125 * _yy);
-                _yy = randy();
+                _yy = DebRandy();
                 current_deb_key->oncount = debinfo->ival_on + (s32)((float)debinfo->ival_on_ran * 0.125 * _yy);
                 for (i = 0; i < 4; i++) {
                     if (debinfo->sounds[i].id == -1) {
@@ -107,7 +107,25 @@ int edbitsLookupInstance(char *name)		//CHECK
   int cmp;
   int i;
   int cnt;
+  int first;
+  int len;
+  struct nunameix_s* ix;
   
+  // a case sensitive match on the first 0x13 chars is always in the folded prefix range for them
+  if ((edbits_base_scene != (nugscn_s *)0x0) && (edbits_base_scene->specialix != NULL)) {
+    ix = edbits_base_scene->specialix;
+    len = strlen(name);
+    if (len > 0x13) {
+      len = 0x13;
+    }
+    cnt = -1;
+    for (i = NuNameIxPrefixRange(ix,name,len,&first); i > 0; i--, first++) {
+      if (((cnt == -1) || (ix->sorted[first] < cnt)) && (strncmp(ix->names[ix->sorted[first]],name,0x13) == 0)) {
+        cnt = ix->sorted[first];
+      }
+    }
+    return cnt;
+  }
   if ((edbits_base_scene != (nugscn_s *)0x0) && (cnt = 0, 0 < edbits_base_scene->numspecial)) {
     i = 0;
     do {
@@ -1,7 +1,28 @@
 //#include "edgra.h"
 #include "../nu.h"
 
-//NGC MATCH
+// Centres of the clumps in use, in SoA for edgraDetermineNearestClump.
+static float edgra_cx[0x40];
+static float edgra_cy[0x40];
+static float edgra_cz[0x40];
+static s32 edgra_ci[0x40];
+static s32 edgra_nactive;
+
+static void edgraIndexClumps(void) {
+  s32 i;
+
+  edgra_nactive = 0;
+  for(i = 0; i < 0x40; i++) {
+    if (GrassClumps[i].num != 0) {
+      edgra_cx[edgra_nactive] = GrassClumps[i].centre.x;
+      edgra_cy[edgra_nactive] = GrassClumps[i].centre.y;
+      edgra_cz[edgra_nactive] = GrassClumps[i].centre.z;
+      edgra_ci[edgra_nactive] = i;
+      edgra_nactive++;
+    }
+  }
+}
+
 void edgraInitAllClumps(void) {
   struct nuvec4_s pos[256];
   s32 i;
@@ -41,40 +62,48 @@ void edgraInitAllClumps(void) {
       edgra_clumps_used++;
     }
   }
+  NuWindBatchBuildAll(edbits_base_scene);
+  edgraIndexClumps();
   return;
 }
 
-//NGC MATCH
 void edgraClumpsReset(void) {
   s32 i;
   
   for(i = 0; i < 0x40; i++) {
     GrassClumps[i].num = 0;
   }
+  edgra_nactive = 0;
   edgra_next_clump = 0;
   return;
 }
 
-//NGC MATCH
+// Only the clumps in use are scanned, four at a time. Ties still go to the lowest clump index.
 void edgraDetermineNearestClump(float ndist) {
-  float dist;
-  s32 i;
+  float dist[0x40];
+  float dist1;
   struct nuvec_s distv;
+  nuf4 dx;
+  nuf4 dy;
+  nuf4 dz;
+  s32 i;
   
     if ((edgra_nearest != -1)) {
         NuVecSub(&distv,&edgra_cam_pos,&GrassClumps[edgra_nearest].centre);
-        dist = (distv.x * distv.x + distv.y * distv.y + distv.z * distv.z);
-        if (dist == 0.0) return;
+        dist1 = (distv.x * distv.x + distv.y * distv.y + distv.z * distv.z);
+        if (dist1 == 0.0) return;
     }
     edgra_nearest = -1;
-    for(i = 0; i < 0x40; i++) {
-        if (GrassClumps[i].num != 0) {
-            NuVecSub(&distv,&edgra_cam_pos,&GrassClumps[i].centre);
-            dist = (distv.x * distv.x + distv.y * distv.y + distv.z * distv.z);
-            if ((ndist < 0.0f) || (dist < ndist)) {
-                ndist = dist;
-                edgra_nearest = i;
-            }
+    for(i = 0; i < edgra_nactive; i += 4) {
+        dx = NuF4Sub(NuF4LoadU(&edgra_cx[i]), NuF4Set1(edgra_cam_pos.x));
+        dy = NuF4Sub(NuF4LoadU(&edgra_cy[i]), NuF4Set1(edgra_cam_pos.y));
+        dz = NuF4Sub(NuF4LoadU(&edgra_cz[i]), NuF4Set1(edgra_cam_pos.z));
+        NuF4StoreU(&dist[i], NuF4Madd(dx, dx, NuF4Madd(dy, dy, NuF4Mul(dz, dz))));
+    }
+    for(i = 0; i < edgra_nactive; i++) {
+        if ((ndist < 0.0f) || (dist[i] < ndist)) {
+            ndist = dist[i];
+            edgra_nearest = edgra_ci[i];
         }
     }
   return;
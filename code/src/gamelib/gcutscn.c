@@ -102,6 +102,8 @@ struct NUGCUTSCENE_s * NuGCutSceneLoad(char *fname,union variptr_u *buff,union v
     }
 
     ASSIGN_IF_SET(cutscene->bbox, (struct NUGCUTBBOX_s*)((s32)cutscene->bbox + cutscene->address_offset));
+
+    NuGCutSceneBake(cutscene, buff, endbuff);
     
     return cutscene;
 }
@@ -295,7 +297,328 @@ inline static void instNuGCutSceneClipTest(struct instNUGCUTSCENE_s *icutscene)
     
 }
 
-//NGC MATCH
+#define NUGCUTBAKE_MAX 32
+
+s32 NuGCutBakeEnabled = 1;
+
+// Keyed on the cutscene pointer so a stale bake is never dereferenced, NuGCutSceneLoad resets the slot on reload.
+static struct NUGCUTSCENE_s* cutscene_bakekey[NUGCUTBAKE_MAX];
+static struct NUGCUTBAKE_s* cutscene_bake[NUGCUTBAKE_MAX];
+static s32 cutscene_bakenext;
+
+static void NuGCutRigidCalcMtx(struct NUGCUTRIGID_s* rigid, float current_frame, struct numtx_s* mtx);
+
+static struct NUGCUTBAKE_s* NuGCutBakeFind(struct NUGCUTSCENE_s* cutscene) {
+    s32 i;
+
+    for (i = 0; i < NUGCUTBAKE_MAX; i++) {
+        if (cutscene_bakekey[i] == cutscene) {
+            return cutscene_bake[i];
+        }
+    }
+    return NULL;
+}
+
+// Split mtx into translation, rotation and per row scale, 0 if that doesn't rebuild it (shear or a zero scale).
+static s32 NuGCutBakeSplit(struct numtx_s* mtx, struct Quat* q, struct nuvec_s* s) {
+    struct numtx_s r;
+    struct numtx_s chk;
+    float* a;
+    float* b;
+    s32 i;
+
+    s->x = NuFsqrt(mtx->_00 * mtx->_00 + mtx->_01 * mtx->_01 + mtx->_02 * mtx->_02);
+    s->y = NuFsqrt(mtx->_10 * mtx->_10 + mtx->_11 * mtx->_11 + mtx->_12 * mtx->_12);
+    s->z = NuFsqrt(mtx->_20 * mtx->_20 + mtx->_21 * mtx->_21 + mtx->_22 * mtx->_22);
+    if ((s->x < 0.000001f) || (s->y < 0.000001f) || (s->z < 0.000001f)) {
+        return 0;
+    }
+    if ((mtx->_00 * (mtx->_11 * mtx->_22 - mtx->_12 * mtx->_21) - mtx->_01 * (mtx->_10 * mtx->_22 - mtx->_12 * mtx->_20)
+         + mtx->_02 * (mtx->_10 * mtx->_21 - mtx->_11 * mtx->_20)) < 0.0f) {
+        s->x = -s->x;
+    }
+    r = *mtx;
+    r._00 /= s->x;
+    r._01 /= s->x;
+    r._02 /= s->x;
+    r._10 /= s->y;
+    r._11 /= s->y;
+    r._12 /= s->y;
+    r._20 /= s->z;
+    r._21 /= s->z;
+    r._22 /= s->z;
+    NuMtxToQuat((struct Mtx*)&r, q);
+    NuQuatToMtx(q, (struct Mtx*)&chk);
+    chk._00 *= s->x;
+    chk._01 *= s->x;
+    chk._02 *= s->x;
+    chk._10 *= s->y;
+    chk._11 *= s->y;
+    chk._12 *= s->y;
+    chk._20 *= s->z;
+    chk._21 *= s->z;
+    chk._22 *= s->z;
+    a = &chk._00;
+    b = &mtx->_00;
+    for (i = 0; i < 12; i++) {
+        if ((i & 3) == 3) {
+            continue;
+        }
+        if (NuFabs(a[i] - b[i]) > 0.001f * (NuFabs(b[i]) + 1.0f)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void NuGCutSceneBake(struct NUGCUTSCENE_s* cutscene, union variptr_u* buff, union variptr_u* endbuff) {
+    struct NUGCUTRIGIDSYS_s* rigidsys;
+    struct NUGCUTRIGID_s* rigid;
+    struct NUGCUTBAKE_s* bake;
+    struct numtx_s mtx;
+    struct Quat q;
+    struct Quat last;
+    struct nuvec_s s;
+    float* p;
+    s32 nsamples;
+    s32 nlanes;
+    s32 nstreams;
+    s32 size;
+    s32 i;
+    s32 k;
+    s32 l;
+
+    for (i = 0; i < NUGCUTBAKE_MAX; i++) {
+        if (cutscene_bakekey[i] == cutscene) {
+            cutscene_bakekey[i] = NULL;
+            cutscene_bake[i] = NULL;
+        }
+    }
+    rigidsys = cutscene->rigids;
+    if ((NuGCutBakeEnabled == 0) || (rigidsys == NULL) || (rigidsys->rigids == NULL) || (cutscene->nframes < 1.0f)) {
+        return;
+    }
+
+    // static rigids just copy their matrix, only animated ones get a lane
+    nlanes = 0;
+    nstreams = 7;
+    for (i = 0; i < rigidsys->nrigids; i++) {
+        rigid = &rigidsys->rigids[i];
+        if (rigid->anim != NULL) {
+            nlanes++;
+            if ((*rigid->anim->curvesetflags & 8) != 0) {
+                nstreams = 10;
+            }
+        }
+    }
+    nlanes = (nlanes + 3) & ~3;
+    if ((nlanes == 0) || (nlanes > NUGCUTBAKE_MAXRIGIDS)) {
+        return;
+    }
+    nsamples = (s32)(cutscene->nframes * NUGCUTBAKE_RATE) + 2;
+    size = nsamples * nstreams * nlanes * sizeof(float);
+    if (size > NUGCUTBAKE_MAXBYTES) {
+        return;
+    }
+    size += sizeof(struct NUGCUTBAKE_s) + rigidsys->nrigids * sizeof(u16) + nlanes * sizeof(struct numtx_s) + 0x30;
+    // the rest of the level still loads into this buffer, so never eat into the reserve
+    if ((s32)endbuff->voidptr - (s32)ALIGN_ADDRESS(buff->voidptr, 0x10) < size + NUGCUTBAKE_RESERVE) {
+        return;
+    }
+
+    bake = buff->voidptr = (void*)ALIGN_ADDRESS(buff->voidptr, 0x10);
+    buff->voidptr = &bake[1];
+    bake->samples = buff->voidptr = (void*)ALIGN_ADDRESS(buff->voidptr, 0x10);
+    buff->voidptr = &bake->samples[nsamples * nstreams * nlanes];
+    bake->mtx = buff->voidptr = (void*)ALIGN_ADDRESS(buff->voidptr, 0x10);
+    buff->voidptr = &bake->mtx[nlanes];
+    bake->lane = buff->voidptr;
+    buff->voidptr = &bake->lane[rigidsys->nrigids];
+    bake->nsamples = nsamples;
+    bake->nlanes = nlanes;
+    bake->nstreams = nstreams;
+    bake->mtxframe = -1.0f;
+    memset(bake->samples, 0, nsamples * nstreams * nlanes * sizeof(float));
+
+    l = 0;
+    for (i = 0; i < rigidsys->nrigids; i++) {
+        rigid = &rigidsys->rigids[i];
+        bake->lane[i] = NUGCUTBAKE_NOLANE;
+        if (rigid->anim == NULL) {
+            continue;
+        }
+        for (k = 0; k < nsamples; k++) {
+            NuGCutRigidCalcMtx(rigid, 1.0f + (float)k / NUGCUTBAKE_RATE, &mtx);
+            if (NuGCutBakeSplit(&mtx, &q, &s) == 0) {
+                break;
+            }
+            // keep neighbouring samples in the same hemisphere so playback can lerp them directly
+            if ((k != 0) && ((q.x * last.x + q.y * last.y + q.z * last.z + q.w * last.w) < 0.0f)) {
+                q.x = -q.x;
+                q.y = -q.y;
+                q.z = -q.z;
+                q.w = -q.w;
+            }
+            last = q;
+            p = &bake->samples[k * nstreams * nlanes + l];
+            p[0] = mtx._30;
+            p[nlanes] = mtx._31;
+            p[nlanes * 2] = mtx._32;
+            p[nlanes * 3] = q.x;
+            p[nlanes * 4] = q.y;
+            p[nlanes * 5] = q.z;
+            p[nlanes * 6] = q.w;
+            if (nstreams == 10) {
+                p[nlanes * 7] = s.x;
+                p[nlanes * 8] = s.y;
+                p[nlanes * 9] = s.z;
+            }
+        }
+        if (k == nsamples) {
+            bake->lane[i] = (u16)l;
+        }
+        l++;
+    }
+
+    i = cutscene_bakenext;
+    cutscene_bakenext = (cutscene_bakenext + 1) % NUGCUTBAKE_MAX;
+    cutscene_bakekey[i] = cutscene;
+    cutscene_bake[i] = bake;
+}
+
+// Every baked rigid's matrix at frame in one pass, four rigids at a time.
+static void NuGCutBakeEval(struct NUGCUTBAKE_s* bake, float frame) {
+    float tmp[12][4];
+    float inv[4];
+    float* a;
+    float* b;
+    float u;
+    nuf4 t;
+    nuf4 tx;
+    nuf4 ty;
+    nuf4 tz;
+    nuf4 qx;
+    nuf4 qy;
+    nuf4 qz;
+    nuf4 qw;
+    nuf4 sx;
+    nuf4 sy;
+    nuf4 sz;
+    nuf4 d;
+    nuf4 one;
+    nuf4 xx;
+    nuf4 yy;
+    nuf4 zz;
+    nuf4 xy;
+    nuf4 xz;
+    nuf4 yz;
+    nuf4 xw;
+    nuf4 yw;
+    nuf4 zw;
+    struct numtx_s* m;
+    s32 n;
+    s32 k;
+    s32 g;
+    s32 i;
+
+    if (bake->mtxframe == frame) {
+        return;
+    }
+    bake->mtxframe = frame;
+    u = (frame - 1.0f) * NUGCUTBAKE_RATE;
+    if (u < 0.0f) {
+        u = 0.0f;
+    }
+    if (u >= (float)(bake->nsamples - 1)) {
+        k = bake->nsamples - 2;
+        u = 1.0f;
+    } else {
+        k = (s32)u;
+        u -= (float)k;
+    }
+    n = bake->nlanes;
+    a = &bake->samples[k * bake->nstreams * n];
+    b = a + bake->nstreams * n;
+    t = NuF4Set1(u);
+    one = NuF4Set1(1.0f);
+    sx = sy = sz = one;
+
+    for (g = 0; g < n; g += 4) {
+        tx = NuF4Madd(NuF4Sub(NuF4Load(&b[g]), NuF4Load(&a[g])), t, NuF4Load(&a[g]));
+        ty = NuF4Madd(NuF4Sub(NuF4Load(&b[n + g]), NuF4Load(&a[n + g])), t, NuF4Load(&a[n + g]));
+        tz = NuF4Madd(NuF4Sub(NuF4Load(&b[n * 2 + g]), NuF4Load(&a[n * 2 + g])), t, NuF4Load(&a[n * 2 + g]));
+        qx = NuF4Madd(NuF4Sub(NuF4Load(&b[n * 3 + g]), NuF4Load(&a[n * 3 + g])), t, NuF4Load(&a[n * 3 + g]));
+        qy = NuF4Madd(NuF4Sub(NuF4Load(&b[n * 4 + g]), NuF4Load(&a[n * 4 + g])), t, NuF4Load(&a[n * 4 + g]));
+        qz = NuF4Madd(NuF4Sub(NuF4Load(&b[n * 5 + g]), NuF4Load(&a[n * 5 + g])), t, NuF4Load(&a[n * 5 + g]));
+        qw = NuF4Madd(NuF4Sub(NuF4Load(&b[n * 6 + g]), NuF4Load(&a[n * 6 + g])), t, NuF4Load(&a[n * 6 + g]));
+        if (bake->nstreams == 10) {
+            sx = NuF4Madd(NuF4Sub(NuF4Load(&b[n * 7 + g]), NuF4Load(&a[n * 7 + g])), t, NuF4Load(&a[n * 7 + g]));
+            sy = NuF4Madd(NuF4Sub(NuF4Load(&b[n * 8 + g]), NuF4Load(&a[n * 8 + g])), t, NuF4Load(&a[n * 8 + g]));
+            sz = NuF4Madd(NuF4Sub(NuF4Load(&b[n * 9 + g]), NuF4Load(&a[n * 9 + g])), t, NuF4Load(&a[n * 9 + g]));
+        }
+
+        // the lerped quaternion isn't unit length, scaling by 2 / |q|^2 still gives the exact rotation
+        d = NuF4Madd(qx, qx, NuF4Madd(qy, qy, NuF4Madd(qz, qz, NuF4Mul(qw, qw))));
+        NuF4StoreU(inv, d);
+        for (i = 0; i < 4; i++) {
+            inv[i] = (inv[i] > 0.0f) ? 2.0f / inv[i] : 0.0f;
+        }
+        d = NuF4LoadU(inv);
+        xx = NuF4Mul(NuF4Mul(qx, qx), d);
+        yy = NuF4Mul(NuF4Mul(qy, qy), d);
+        zz = NuF4Mul(NuF4Mul(qz, qz), d);
+        xy = NuF4Mul(NuF4Mul(qx, qy), d);
+        xz = NuF4Mul(NuF4Mul(qx, qz), d);
+        yz = NuF4Mul(NuF4Mul(qy, qz), d);
+        xw = NuF4Mul(NuF4Mul(qx, qw), d);
+        yw = NuF4Mul(NuF4Mul(qy, qw), d);
+        zw = NuF4Mul(NuF4Mul(qz, qw), d);
+
+        // same layout as NuQuatToMtx, rows scaled like NuMtxPreScale
+        NuF4StoreU(tmp[0], NuF4Mul(NuF4Sub(one, NuF4Add(yy, zz)), sx));
+        NuF4StoreU(tmp[1], NuF4Mul(NuF4Add(xy, zw), sx));
+        NuF4StoreU(tmp[2], NuF4Mul(NuF4Sub(xz, yw), sx));
+        NuF4StoreU(tmp[3], NuF4Mul(NuF4Sub(xy, zw), sy));
+        NuF4StoreU(tmp[4], NuF4Mul(NuF4Sub(one, NuF4Add(xx, zz)), sy));
+        NuF4StoreU(tmp[5], NuF4Mul(NuF4Add(yz, xw), sy));
+        NuF4StoreU(tmp[6], NuF4Mul(NuF4Add(xz, yw), sz));
+        NuF4StoreU(tmp[7], NuF4Mul(NuF4Sub(yz, xw), sz));
+        NuF4StoreU(tmp[8], NuF4Mul(NuF4Sub(one, NuF4Add(xx, yy)), sz));
+        NuF4StoreU(tmp[9], tx);
+        NuF4StoreU(tmp[10], ty);
+        NuF4StoreU(tmp[11], tz);
+
+        for (i = 0, m = &bake->mtx[g]; i < 4; i++, m++) {
+            m->_00 = tmp[0][i];
+            m->_01 = tmp[1][i];
+            m->_02 = tmp[2][i];
+            m->_03 = 0.0f;
+            m->_10 = tmp[3][i];
+            m->_11 = tmp[4][i];
+            m->_12 = tmp[5][i];
+            m->_13 = 0.0f;
+            m->_20 = tmp[6][i];
+            m->_21 = tmp[7][i];
+            m->_22 = tmp[8][i];
+            m->_23 = 0.0f;
+            m->_30 = tmp[9][i];
+            m->_31 = tmp[10][i];
+            m->_32 = tmp[11][i];
+            m->_33 = 1.0f;
+        }
+    }
+}
+
+// Rigid i's matrix from the bake if it has a lane, otherwise from its curves.
+static void NuGCutRigidMtx(struct NUGCUTBAKE_s* bake, s32 i, struct NUGCUTRIGID_s* rigid, float current_frame, struct numtx_s* mtx) {
+    if ((bake != NULL) && (bake->lane[i] != NUGCUTBAKE_NOLANE)) {
+        NuGCutBakeEval(bake, current_frame);
+        *mtx = bake->mtx[bake->lane[i]];
+    } else {
+        NuGCutRigidCalcMtx(rigid, current_frame, mtx);
+    }
+}
+
 static void instNuGCutRigidSysUpdate(struct instNUGCUTSCENE_s* icutscene, float current_frame) {   
     struct NUGCUTRIGID_s *rigid; 
     struct instNUGCUTRIGID_s *irigid;
@@ -312,11 +635,13 @@ static void instNuGCutRigidSysUpdate(struct instNUGCUTSCENE_s* icutscene, float
     // ------------------------------------------
     struct NUGCUTLOCATOR_s *locator;
     struct instNUGCUTLOCATOR_s *iloctemp;
+    struct NUGCUTBAKE_s *bake;
 
     
     cutscene = icutscene->cutscene;
     irigidsys = icutscene->irigids;
     rigidsys = cutscene->rigids;
+    bake = NuGCutBakeFind(cutscene);
     
     for(i = 0; i < rigidsys->nrigids; i++)
     {
@@ -343,7 +668,7 @@ static void instNuGCutRigidSysUpdate(struct instNUGCUTSCENE_s* icutscene, float
         
         if ( ((irigid->special).special)->instance->flags.visible != 0)
         {
-            NuGCutRigidCalcMtx(rigid, current_frame, &mtx);
+            NuGCutRigidMtx(bake, i, rigid, current_frame, &mtx);
             
             if ((icutscene->has_mtx) != 0)
             {
@@ -1199,7 +1524,6 @@ static void instNuGCutRigidSysStart(struct instNUGCUTRIGIDSYS_s *irigidsys,struc
   }
 }
 
-//NGC MATCH
 static void instNuGCutRigidSysRender(struct instNUGCUTSCENE_s *icutscene,float current_frame) {
 
     s32 i;
@@ -1217,10 +1541,12 @@ static void instNuGCutRigidSysRender(struct instNUGCUTSCENE_s *icutscene,float c
     struct NUGCUTLOCATOR_s *loctemp1;
     struct instNUGCUTLOCATOR_s *iloctemp2;
     struct instNUGCUTRIGID_s *irigidtemp;
+    struct NUGCUTBAKE_s *bake;
     
     irigidsys = icutscene->irigids;
     cutscene = icutscene->cutscene;
     rigidsys = cutscene->rigids;
+    bake = NuGCutBakeFind(cutscene);
     
     for(i = 0; i < rigidsys->nrigids; i++) {
         rigidtemp = &rigidsys->rigids[i];
@@ -1245,7 +1571,7 @@ static void instNuGCutRigidSysRender(struct instNUGCUTSCENE_s *icutscene,float c
             }
         
         if ((((irigidtemp->special).special)->instance->flags.visible)) {
-            NuGCutRigidCalcMtx(rigidtemp, current_frame, &mtx);
+            NuGCutRigidMtx(bake, i, rigidtemp, current_frame, &mtx);
             
             if (icutscene->has_mtx != 0) {
                 NuMtxMul(&mtx, &mtx, &icutscene->mtx);
@@ -62,6 +62,33 @@ struct NUCUTSCENECAMERA_s {
     struct nucamera_s * camera;
 };
 
+// Rigid tracks sampled at load, NUGCUTBAKE_RATE samples per cutscene frame (60 Hz at the usual playback rate of 0.5).
+#define NUGCUTBAKE_RATE 2
+#define NUGCUTBAKE_MAXRIGIDS 256
+#define NUGCUTBAKE_MAXBYTES 0x100000
+#define NUGCUTBAKE_RESERVE 0x200000 // load buffer left free after a bake
+#define NUGCUTBAKE_NOLANE 0xffff
+
+// Size: 0x1C
+struct NUGCUTBAKE_s {
+    s32 nsamples;
+    s32 nlanes; // multiple of 4
+    s32 nstreams; // tx ty tz qx qy qz qw, then sx sy sz if any rigid scales
+    u16* lane; // per rigid, NUGCUTBAKE_NOLANE if it's still evaluated from its curves
+    float* samples; // [nsamples][nstreams][nlanes]
+    struct numtx_s* mtx; // last batch, nlanes matrices
+    float mtxframe;
+};
+
+struct NUGCUTSCENE_s;
+
+// A bake is sized from the cutscene's frame count and animated rigids, up to NUGCUTBAKE_MAXBYTES. Cutscenes that would
+// leave less than NUGCUTBAKE_RESERVE of the load buffer free keep evaluating their curves.
+extern s32 NuGCutBakeEnabled;
+
+// Bake the cutscene's rigid tracks into the buffer, called by NuGCutSceneLoad.
+void NuGCutSceneBake(struct NUGCUTSCENE_s* cutscene, union variptr_u* buff, union variptr_u* endbuff);
+
 typedef void(*NuCutSceneCharacterCreateData)(struct NUGCUTCHAR_s*, struct instNUGCUTCHAR_s*, union variptr_u*);
 
 
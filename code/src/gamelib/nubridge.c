@@ -1,27 +1,48 @@
+#include "../nu.h"
+
+#define NUBRIDGE_SECTIONS 24
+// Rope arrays hold section s at lane s + 1, the spare lanes either side let the solver load neighbours four at a time.
+#define NUBRIDGE_LANES 32
+// A bridge that has moved less than this a frame for NUBRIDGE_SLEEPFRAMES frames stops being solved.
+#define NUBRIDGE_SLEEPVEL 0.0005f
+#define NUBRIDGE_SLEEPFRAMES 30
+
+// One rope of points, a component at a time.
+// Size: 0x180
+struct nubridgerope_s {
+    float x[NUBRIDGE_LANES];
+    float y[NUBRIDGE_LANES];
+    float z[NUBRIDGE_LANES];
+};
+
 typedef struct {
-    // total size: 0xB4C
-    struct nuvec_s pos[24][2]; // offset 0x0, size 0x240
-    struct nuvec_s vel[24][2]; // offset 0x240, size 0x240
-    struct numtx_s mtx[24]; // offset 0x480, size 0x600
-    struct nuinstance_s * instance[24]; // offset 0xA80, size 0x60
-    struct nuinstance_s * ipost; // offset 0xAE0, size 0x4
-    struct nuvec_s center; // offset 0xAE4, size 0xC
-    float radius; // offset 0xAF0, size 0x4
-    short plat[24]; // offset 0xAF4, size 0x30
-    char inrange; // offset 0xB24, size 0x1
-    char onscreen; // offset 0xB25, size 0x1
-    char sections; // offset 0xB26, size 0x1
-    char postint; // offset 0xB27, size 0x1
-    int colour; // offset 0xB28, size 0x4
-    short hit; // offset 0xB2C, size 0x2
-    short yang; // offset 0xB2E, size 0x2
-    float width; // offset 0xB30, size 0x4
-    float tension; // offset 0xB34, size 0x4
-    float gravity; // offset 0xB38, size 0x4
-    float damp; // offset 0xB3C, size 0x4
-    float plrweight; // offset 0xB40, size 0x4
-    float postw; // offset 0xB44, size 0x4
-    float posth; // offset 0xB48, size 0x4
+    // total size: 0xD50
+    struct nubridgerope_s pos[2]; // offset 0x0, size 0x300
+    struct nubridgerope_s vel[2]; // offset 0x300, size 0x300
+    float live[NUBRIDGE_LANES]; // offset 0x600, size 0x80, 1 for the lanes that move, 0 for the ends and spares
+    struct numtx_s mtx[24]; // offset 0x680, size 0x600
+    struct nuinstance_s * instance[24]; // offset 0xC80, size 0x60
+    struct nuinstance_s * ipost; // offset 0xCE0, size 0x4
+    struct nuvec_s center; // offset 0xCE4, size 0xC
+    float radius; // offset 0xCF0, size 0x4
+    short plat[24]; // offset 0xCF4, size 0x30
+    char inrange; // offset 0xD24, size 0x1
+    char onscreen; // offset 0xD25, size 0x1
+    char sections; // offset 0xD26, size 0x1
+    char postint; // offset 0xD27, size 0x1
+    int colour; // offset 0xD28, size 0x4
+    short hit; // offset 0xD2C, size 0x2
+    short yang; // offset 0xD2E, size 0x2
+    float width; // offset 0xD30, size 0x4
+    float tension; // offset 0xD34, size 0x4
+    float gravity; // offset 0xD38, size 0x4
+    float damp; // offset 0xD3C, size 0x4
+    float plrweight; // offset 0xD40, size 0x4
+    float postw; // offset 0xD44, size 0x4
+    float posth; // offset 0xD48, size 0x4
+    short still; // offset 0xD4C, size 0x2
+    char asleep; // offset 0xD4E, size 0x1
+    char pad; // offset 0xD4F, size 0x1
 } BridgeType;
 
 BridgeType Bridges[8];
@@ -66,7 +87,6 @@ void NuBridgeInit(void) {
     BridgeFree = 0;
 }
 
-//NGC MATCH
 s32* NuBridgeCreate(struct nuinstance_s** instance,struct nuinstance_s* ipost,struct nuvec_s* start,struct nuvec_s* end,float width,
     short yang,float tension,float damp,float gravity,float plrweight,s32 sections,float postw,float posth,s32 postint,s32 colour) {
  
@@ -74,14 +94,19 @@ s32* NuBridgeCreate(struct nuinstance_s** instance,struct nuinstance_s* ipost,st
     struct nuvec_s dir90; // 0x18(r1)
     BridgeType* bridge;
     s32 lp;
+    s32 ln;
     float t;
 
-    if (sections > 24) {
+    if (sections > NUBRIDGE_SECTIONS) {
         printf("to many sections/n");
+        sections = NUBRIDGE_SECTIONS;
     }
     NuBridgeOn(1);
     bridge = NuBridgeAlloc();
     if (bridge != NULL) {
+        memset(bridge->pos,0,sizeof(bridge->pos));
+        memset(bridge->vel,0,sizeof(bridge->vel));
+        memset(bridge->live,0,sizeof(bridge->live));
         bridge->tension = tension;
         bridge->damp = damp;
         bridge->gravity = gravity;
@@ -93,6 +118,9 @@ s32* NuBridgeCreate(struct nuinstance_s** instance,struct nuinstance_s* ipost,st
         bridge->colour = colour;
         bridge->sections = sections;
         bridge->width = width;
+        bridge->onscreen = 0;
+        bridge->still = 0;
+        bridge->asleep = 0;
         
         (bridge->center).x = (end->x + start->x) * 0.5f;
         (bridge->center).y = (end->y + start->y) * 0.5f;
@@ -127,21 +155,17 @@ s32* NuBridgeCreate(struct nuinstance_s** instance,struct nuinstance_s* ipost,st
             bridge->mtx[lp]._31 = ((dir.y * lp) / (sections - 1)) + start->y;
             bridge->mtx[lp]._32 = ((dir.z * lp) / (sections - 1)) + start->z;
             
-            bridge->pos[lp][0].x = ((dir.x * lp) / (sections - 1) + start->x) - (dir90.x * width * 0.5f);
-            bridge->pos[lp][0].y = (dir.y * lp) / (sections - 1) + start->y;
-            bridge->pos[lp][0].z = ((dir.z * lp) / (sections - 1) + start->z) - (dir90.z * width * 0.5f);
+            ln = lp + 1;
+            bridge->pos[0].x[ln] = ((dir.x * lp) / (sections - 1) + start->x) - (dir90.x * width * 0.5f);
+            bridge->pos[0].y[ln] = (dir.y * lp) / (sections - 1) + start->y;
+            bridge->pos[0].z[ln] = ((dir.z * lp) / (sections - 1) + start->z) - (dir90.z * width * 0.5f);
             
-            bridge->pos[lp][1].x = ((dir.x * lp) / (sections - 1) + start->x) + (dir90.x * width * 0.5f);
-            bridge->pos[lp][1].y = (dir.y * lp) / (sections - 1) + start->y;
-            bridge->pos[lp][1].z = ((dir.z * lp) / (sections - 1) + start->z) + (dir90.z * width * 0.5f);
+            bridge->pos[1].x[ln] = ((dir.x * lp) / (sections - 1) + start->x) + (dir90.x * width * 0.5f);
+            bridge->pos[1].y[ln] = (dir.y * lp) / (sections - 1) + start->y;
+            bridge->pos[1].z[ln] = ((dir.z * lp) / (sections - 1) + start->z) + (dir90.z * width * 0.5f);
             
-            bridge->vel[lp][0].x = 0.0f;
-            bridge->vel[lp][0].y = 0.0f;
-            bridge->vel[lp][0].z = 0.0f;
-            
-            bridge->vel[lp][1].x = 0.0f;
-            bridge->vel[lp][1].y = 0.0f;
-            bridge->vel[lp][1].z = 0.0f;
+            // the first and last sections are tied to the banks
+            bridge->live[ln] = ((lp > 0) && (lp < sections - 1)) ? 1.0f : 0.0f;
             bridge->hit = 0;
         }
     }
@@ -441,302 +465,255 @@ void NuBridgeDraw(struct nugscn_s *scn,struct numtl_s *mtl) {
     return;
 }
 
-//61% NGC
+// Push the sections either side of the player down, more on the rope they're leaning towards.
+static void NuBridgePlayerPush(BridgeType *bridge,struct nuvec_s *playerpos) {
+    struct nuvec_s a;
+    struct nuvec_s along;
+    s32 last;
+    s32 s;
+    float len2;
+    float t;
+    float frac;
+    float side;
+    float w0;
+    float w1;
+
+    last = bridge->sections;
+    a.x = (bridge->pos[0].x[1] + bridge->pos[1].x[1]) * 0.5f;
+    a.z = (bridge->pos[0].z[1] + bridge->pos[1].z[1]) * 0.5f;
+    along.x = (bridge->pos[0].x[last] + bridge->pos[1].x[last]) * 0.5f - a.x;
+    along.z = (bridge->pos[0].z[last] + bridge->pos[1].z[last]) * 0.5f - a.z;
+    len2 = along.x * along.x + along.z * along.z;
+    if (len2 <= 0.0f) {
+        return;
+    }
+    t = ((along.x * (playerpos->x - a.x) + along.z * (playerpos->z - a.z)) * (bridge->sections - 1)) / len2;
+    if (t < 0.0f) {
+        t = 0.0f;
+    }
+    if (t > (bridge->sections - 1)) {
+        t = (bridge->sections - 1);
+    }
+    s = (s32)t;
+    frac = t - s;
+    side = (2.0f / (NuFsqrt(len2) * bridge->width)) * (along.z * (playerpos->x - a.x) - along.x * (playerpos->z - a.z));
+    if (side > 1.0f) {
+        side = 1.0f;
+    }
+    if (side < -1.0f) {
+        side = -1.0f;
+    }
+    w0 = bridge->gravity * (3.0f - side) * 0.25f * bridge->plrweight;
+    w1 = bridge->gravity * (side + 3.0f) * 0.25f * bridge->plrweight;
+
+    // live is 0 on the banks so they don't take any of it
+    s++;
+    bridge->vel[0].y[s] += w0 * (1.0f - frac) * bridge->live[s];
+    bridge->vel[1].y[s] += w1 * (1.0f - frac) * bridge->live[s];
+    if (frac > 0.0f) {
+        bridge->vel[0].y[s + 1] += w0 * frac * bridge->live[s + 1];
+        bridge->vel[1].y[s + 1] += w1 * frac * bridge->live[s + 1];
+    }
+}
+
+// Spring pull from the neighbouring point on the rope, stiffer the further it's stretched.
+static inline nuf4 NuBridgeSpring(nuf4 d,nuf4 tension,nuf4 half) {
+    return NuF4Mul(NuF4Madd(NuF4Mul(NuF4Abs(d),d),half,d),tension);
+}
+
+// Step both ropes four sections at a time, returns the biggest velocity component.
+static float NuBridgeSolve(BridgeType *bridge) {
+    struct nubridgerope_s *p;
+    struct nubridgerope_s *v;
+    nuf4 damp;
+    nuf4 gravity;
+    nuf4 tension;
+    nuf4 half;
+    nuf4 live;
+    nuf4 vx;
+    nuf4 vy;
+    nuf4 vz;
+    nuf4 px;
+    nuf4 py;
+    nuf4 pz;
+    nuf4 maxvel;
+    float out[4];
+    s32 r;
+    s32 ln;
+
+    damp = NuF4Set1(1.0f - bridge->damp);
+    gravity = NuF4Set1(bridge->gravity);
+    tension = NuF4Set1(bridge->tension);
+    half = NuF4Set1(0.5f);
+    maxvel = NuF4Set1(0.0f);
+    for (r = 0; r < 2; r++) {
+        p = &bridge->pos[r];
+        v = &bridge->vel[r];
+        // every lane reads the old positions, so the sections can all be stepped at once
+        for (ln = 1; ln <= bridge->sections; ln += 4) {
+            px = NuF4LoadU(&p->x[ln]);
+            py = NuF4LoadU(&p->y[ln]);
+            pz = NuF4LoadU(&p->z[ln]);
+            vx = NuF4Mul(NuF4LoadU(&v->x[ln]),damp);
+            vy = NuF4Madd(NuF4LoadU(&v->y[ln]),damp,gravity);
+            vz = NuF4Mul(NuF4LoadU(&v->z[ln]),damp);
+            vx = NuF4Add(vx,NuF4Add(NuBridgeSpring(NuF4Sub(NuF4LoadU(&p->x[ln - 1]),px),tension,half),
+                                    NuBridgeSpring(NuF4Sub(NuF4LoadU(&p->x[ln + 1]),px),tension,half)));
+            vy = NuF4Add(vy,NuF4Add(NuBridgeSpring(NuF4Sub(NuF4LoadU(&p->y[ln - 1]),py),tension,half),
+                                    NuBridgeSpring(NuF4Sub(NuF4LoadU(&p->y[ln + 1]),py),tension,half)));
+            vz = NuF4Add(vz,NuF4Add(NuBridgeSpring(NuF4Sub(NuF4LoadU(&p->z[ln - 1]),pz),tension,half),
+                                    NuBridgeSpring(NuF4Sub(NuF4LoadU(&p->z[ln + 1]),pz),tension,half)));
+            live = NuF4LoadU(&bridge->live[ln]);
+            vx = NuF4Mul(vx,live);
+            vy = NuF4Mul(vy,live);
+            vz = NuF4Mul(vz,live);
+            NuF4StoreU(&v->x[ln],vx);
+            NuF4StoreU(&v->y[ln],vy);
+            NuF4StoreU(&v->z[ln],vz);
+            maxvel = NuF4Max(maxvel,NuF4Max(NuF4Abs(vx),NuF4Max(NuF4Abs(vy),NuF4Abs(vz))));
+        }
+        // positions move only once every velocity has been worked out from the old ones
+        for (ln = 1; ln <= bridge->sections; ln += 4) {
+            NuF4StoreU(&p->x[ln],NuF4Add(NuF4LoadU(&p->x[ln]),NuF4LoadU(&v->x[ln])));
+            NuF4StoreU(&p->y[ln],NuF4Add(NuF4LoadU(&p->y[ln]),NuF4LoadU(&v->y[ln])));
+            NuF4StoreU(&p->z[ln],NuF4Add(NuF4LoadU(&p->z[ln]),NuF4LoadU(&v->z[ln])));
+        }
+    }
+    NuF4StoreU(out,maxvel);
+    for (r = 1; r < 4; r++) {
+        if (out[r] > out[0]) {
+            out[0] = out[r];
+        }
+    }
+    return out[0];
+}
+
+// Plank matrices straight from the ropes: the bridge's yaw, tilted across by the rope height difference and
+// along by the slope between the neighbouring planks. Same as SetRotationY, PreRotateX, PreRotateZ without the angles.
+static void NuBridgeBuildMtx(BridgeType *bridge) {
+    struct numtx_s *m;
+    struct nubridgerope_s *p0;
+    struct nubridgerope_s *p1;
+    float sy;
+    float cy;
+    float sx;
+    float cx;
+    float sz;
+    float cz;
+    float dx;
+    float dy;
+    float dz;
+    float h;
+    float l;
+    float r1x;
+    float r1y;
+    float r1z;
+    s32 ln;
+    s32 prev;
+    s32 next;
+
+    sy = NuTrigTable[(u16)bridge->yang];
+    cy = NuTrigTable[(u16)(bridge->yang + 0x4000)];
+    p0 = &bridge->pos[0];
+    p1 = &bridge->pos[1];
+    for (ln = 1; ln <= bridge->sections; ln++) {
+        m = &bridge->mtx[ln - 1];
+
+        dx = p1->x[ln] - p0->x[ln];
+        dy = p1->y[ln] - p0->y[ln];
+        dz = p1->z[ln] - p0->z[ln];
+        h = NuFsqrt(dx * dx + dz * dz);
+        l = NuFsqrt(h * h + dy * dy);
+        if (l > 0.0f) {
+            sx = dy / l;
+            cx = h / l;
+        } else {
+            sx = 0.0f;
+            cx = 1.0f;
+        }
+
+        prev = (ln > 1) ? ln - 1 : ln;
+        next = (ln < bridge->sections) ? ln + 1 : ln;
+        dx = ((p0->x[next] + p1->x[next]) - (p0->x[prev] + p1->x[prev])) * 0.5f;
+        dy = ((p0->y[next] + p1->y[next]) - (p0->y[prev] + p1->y[prev])) * 0.5f;
+        dz = ((p0->z[next] + p1->z[next]) - (p0->z[prev] + p1->z[prev])) * 0.5f;
+        h = NuFsqrt(dx * dx + dz * dz);
+        l = NuFsqrt(h * h + dy * dy);
+        if (l > 0.0f) {
+            sz = dy / l;
+            cz = h / l;
+        } else {
+            sz = 0.0f;
+            cz = 1.0f;
+        }
+
+        r1x = sx * sy;
+        r1y = cx;
+        r1z = sx * cy;
+        m->_00 = cz * cy + sz * r1x;
+        m->_01 = sz * r1y;
+        m->_02 = sz * r1z - cz * sy;
+        m->_03 = 0.0f;
+        m->_10 = cz * r1x - sz * cy;
+        m->_11 = cz * r1y;
+        m->_12 = cz * r1z + sz * sy;
+        m->_13 = 0.0f;
+        m->_20 = cx * sy;
+        m->_21 = -sx;
+        m->_22 = cx * cy;
+        m->_23 = 0.0f;
+        m->_30 = (p0->x[ln] + p1->x[ln]) * 0.5f;
+        m->_31 = (p0->y[ln] + p1->y[ln]) * 0.5f;
+        m->_32 = (p0->z[ln] + p1->z[ln]) * 0.5f;
+        m->_33 = 1.0f;
+    }
+}
+
 void NuBridgeUpdate(struct nuvec_s *playerpos) {
-  s32 i;
-  BridgeType *bridge;
-  struct nuvec_s dir; // ??
-  //float fVar2;
-  float fVar3;
-  float fVar7;
-  float fVar8;
-  s32 uVar9;
-  s32 iVar10;
-  s32 iVar11;
-  s32 sections;
-  s32 iVar12;
-  s32 iVar13;
-  s32 iVar14;
-  float dVar15;
-  //double dVar16;
-  //double dVar17;
-  float dVar18;
-  //double dVar19;
-  float dVar20;
-  float dVar21;
-  float fVar22;
-  float fVar23;
-  float fVar24;
-  //double local_80;
-  //struct numtx_s *m;
-  //struct numtx_s *m_00;
-  //BridgeType *bridge2;
-  //BridgeType *bridgetmp;
-  
-  if (NuBridgeProc != 0) {
-    //i = 0;
-    bridge = Bridges;
-    //if (0 < BridgeFree) {
-      //dVar16 = 3.0;
-      //dVar17 = 0.5f;
-      for (i = 0; i < BridgeFree; i++) {
-        fVar24 = (bridge->center).x - global_camera.mtx._30;
-        fVar22 = (bridge->center).y - global_camera.mtx._31;
-        fVar23 = (bridge->center).z - global_camera.mtx._32;
-        if (global_camera.farclip * global_camera.farclip + bridge->radius <
-            fVar23 * fVar23 + fVar24 * fVar24 + fVar22 * fVar22) {
-          bridge->inrange = 1;
-          if (bridge->onscreen != 0) {
-            if (bridge->hit != 0) {
-              //dVar20 = 0.5f;
-              sections = bridge->sections;
-              //fVar22 = bridge->pos[0]->x;
-              //fVar24 = bridge->pos[1]->x;
-              //local_80 = sections - 1;
-              fVar7 = ((((bridge->pos[0][sections].x) + (bridge->pos[sections][0].z)) - bridge->pos[0]->x) - fVar24) * 0.5f;
-              //fVar23 = bridge->pos[0]->z;
-              //dVar18 = 0.0f;
-              //fVar2 = bridge->pos[1]->z;
-              fVar8 = ((((bridge->pos[sections][1].x) +
-                        bridge->pos[sections][1].y) - bridge->pos[sections][1].z) - bridge->pos[1]->z) * 0.5f;
-              fVar3 = fVar7 * fVar7 + fVar8 * fVar8;
-              dVar21 = (((fVar7 * (playerpos->x - (bridge->pos[0]->x + fVar24) * 0.5f) +
-                                 fVar8 * (playerpos->z - (bridge->pos[sections][1].z + bridge->pos[1]->z) * 0.5f)) *
-                                (sections - 1)) / fVar3);
-              if (dVar21 < 0.0f) {
-                dVar21 = 0.0f;
-              }
-              //dVar19 = 1.0;
-              //local_80 = sections;
-              dVar15 = ((sections) - 1.0f);
-              if (dVar15 > dVar21) {
-              sections = (s32)dVar21;
-              }
-                dVar21 = dVar15;
-              //local_80 = sections;
-              dVar15 = (dVar21 - (sections));
-              //fVar22 = NuFsqrt(fVar3);
-              dVar21 = ((2.0f / (NuFsqrt(fVar3) * bridge->width)) * (fVar8 * (playerpos->x - ((bridge->pos[0]->x + bridge->pos[1]->x) * 0.5f)) +
-                               fVar7 * ((bridge->pos[0]->z + bridge->pos[1]->z) * 0.5f - playerpos->z)));
-              if (dVar21 > 1.0f) {
-                dVar21 = 1.0f;
-              }
-              if (dVar21 < - 1.0f) {
-                dVar21 = - 1.0f;
-              }
-              fVar22 = bridge->gravity * (dVar21 + 3.0f) * 0.25f;
-              fVar24 = bridge->gravity * (3.0f - dVar21) * 0.25f;
-              if (dVar15 == 0.0f) {
-                if ((sections > 0) && (sections < bridge->sections - 1)) {
-                  bridge->vel[sections][0].y = fVar24 * bridge->plrweight + bridge->vel[sections][0].y;
-                  fVar22 = fVar22 * bridge->plrweight + bridge->vel[sections][1].y;
-                  uVar9 = sections;
-                  bridge->vel[uVar9][1].y = fVar22;
-                }
-              }
-              else {
-                if ((sections > 0) && (sections < bridge->sections - 1)) {
-                  bridge->vel[sections][0].y =
-                       fVar24 * bridge->plrweight * (1.0f - dVar15) + bridge->vel[sections][0].y;
-                  bridge->vel[sections + 1]->y =
-                       fVar22 * bridge->plrweight * (1.0f - dVar15) + bridge->vel[sections][1].y;
-                }
-                uVar9 = sections + 1;
-                if ((s32)uVar9 < bridge->sections - 1) {
-                  bridge->vel[sections][2].y = ((fVar24 * bridge->plrweight) * dVar15 +
-                              bridge->vel[sections][2].y);
-                  bridge->vel[uVar9][1].y = ((fVar22 * bridge->plrweight) * dVar15 + bridge->vel[sections][3].y);
-                  //bridge->vel[uVar9][1].y = fVar22;
+    s32 i;
+    s32 lp;
+    BridgeType *bridge;
+    float dx;
+    float dy;
+    float dz;
+
+    if (NuBridgeProc != 0) {
+        bridge = Bridges;
+        for (i = 0; i < BridgeFree; i++, bridge++) {
+            dx = (bridge->center).x - global_camera.mtx._30;
+            dy = (bridge->center).y - global_camera.mtx._31;
+            dz = (bridge->center).z - global_camera.mtx._32;
+            if (dx * dx + dy * dy + dz * dz > global_camera.farclip * global_camera.farclip + bridge->radius) {
+                bridge->inrange = 0;
+                continue;
+            }
+            bridge->inrange = 1;
+            if (bridge->onscreen == 0) {
+                continue;
+            }
+            for (lp = 0; lp < bridge->sections; lp++) {
+                if (PlatInstGetHit((s32)bridge->plat[lp]) != 0) {
+                    bridge->hit = 5;
                 }
-              }
-              bridge->hit--;
             }
-            iVar10 = PlatInstGetHit((s32)bridge->plat[0]);
-            if (iVar10 != 0) {
-              bridge->hit = 5;
+            if (bridge->hit != 0) {
+                NuBridgePlayerPush(bridge,playerpos);
+                bridge->hit--;
+                bridge->asleep = 0;
+                bridge->still = 0;
             }
-            iVar10 = PlatInstGetHit((s32)bridge->plat[bridge->sections - 1]);
-            if (iVar10 != 0) {
-              bridge->hit = 5;
+            if (bridge->asleep != 0) {
+                continue;
             }
-            //iVar10 = 1;
-            //m = bridge->mtx;
-            //if (1 < bridge->sections - 1) {
-              //dVar21 = 0.5f;
-              iVar12 = 0x30;
-              iVar13 = 0;
-              iVar14 = 0x18;
-              //bridgetmp = bridge;
-              for (iVar10 = 1; iVar10 < bridge->sections - 1; iVar10++, iVar13++) {
-                //bridge2 = (BridgeType *)(bridgetmp->pos + 2);
-                //fVar22 = bridgetmp->vel[2]->x;
-                //fVar24 = bridgetmp->vel[2]->y;
-                //fVar23 = bridgetmp->vel[2]->z;
-                //fVar22 = bridgetmp->vel[3]->x;
-                //fVar2 = bridgetmp->vel[3]->y;
-                //fVar3 = bridgetmp->vel[3]->z;
-                Bridges[iVar10].vel[2]->x = -Bridges[iVar10].vel[2]->x * bridge->damp + Bridges[iVar10].vel[2]->x;
-                Bridges[iVar10].vel[2]->y = Bridges[iVar10].vel[2]->y + (bridge->gravity - Bridges[iVar10].vel[2]->y * bridge->damp);
-                Bridges[iVar10].vel[2]->z = -Bridges[iVar10].vel[2]->z * bridge->damp + Bridges[iVar10].vel[2]->z;
-                Bridges[iVar10].vel[3]->x = -Bridges[iVar10].vel[3]->x * bridge->damp + Bridges[iVar10].vel[3]->x;
-                Bridges[iVar10].vel[3]->y = Bridges[iVar10].vel[3]->y + (bridge->gravity - Bridges[iVar10].vel[3]->y * bridge->damp);
-                Bridges[iVar10].vel[3]->z = -Bridges[iVar10].vel[3]->z * bridge->damp + Bridges[iVar10].vel[3]->z;
-                iVar11 = PlatInstGetHit((s32)bridge->plat[iVar10]);
-                if (iVar11 != 0) {
-                  bridge->hit = 5;
+            if ((NuBridgeSolve(bridge) < NUBRIDGE_SLEEPVEL) && (bridge->hit == 0)) {
+                if (++bridge->still >= NUBRIDGE_SLEEPFRAMES) {
+                    bridge->asleep = 1;
                 }
-                //iVar10 = iVar10 + 1;
-                dVar20 = NuFabs((Bridges[iVar10].pos[0]->x - bridge->pos[2]->x));
-                dVar18 = (Bridges[iVar10].pos[0]->x - bridge->pos[2]->x);
-                Bridges[iVar10].vel[2]->x = Bridges[iVar10].vel[2]->x +(((dVar20 * dVar18) * bridge->tension) * 0.5f +
-                            (dVar18 * bridge->tension));
-                dVar20 = NuFabs(bridge->pos[iVar13]->y - bridge->pos[iVar14]->y);
-                dVar18 = bridge->pos[iVar13]->y - bridge->pos[iVar14]->y;
-                Bridges[iVar10].vel[2]->y = Bridges[iVar10].vel[2]->y + (((dVar20 * dVar18) *
-                                            bridge->tension) * 0.5f + (dVar18 * bridge->tension));
-                dVar20 = NuFabs(((bridge->pos[iVar13]->z) - (bridge->pos[iVar14]->z)));
-                dVar18 = ((bridge->pos[iVar13]->z) - (bridge->pos[iVar14]->z));
-                //fVar22 = bridgetmp->pos[4]->x;
-                //fVar24 = bridge2->pos[0]->x;
-                Bridges[iVar10].vel[2]->z = Bridges[iVar10].vel[2]->z + (((dVar20 * dVar18) *
-                                            bridge->tension) * 0.5f + (dVar18 * bridge->tension));
-                dVar20 = NuFabs((Bridges[iVar10].pos[4]->x - bridge->pos[2]->x));
-                dVar18 = (Bridges[iVar10].pos[4]->x - bridge->pos[2]->x);
-                Bridges[iVar10].vel[2]->x = Bridges[iVar10].vel[2]->x +
-                     (((dVar20 * dVar18) * bridge->tension) * 0.5f + (dVar18 * bridge->tension));
-                dVar20 = NuFabs((bridge->pos[iVar12][0].y - bridge->pos[iVar14][0].y));
-                dVar18 = (bridge->pos[iVar12][0].y - bridge->pos[iVar14][0].y);
-                Bridges[iVar10].vel[2]->y = Bridges[iVar10].vel[2]->y +
-                     (((dVar20 * dVar18) * bridge->tension) * 0.5f + (dVar18 * bridge->tension));
-                dVar20 = NuFabs(bridge->pos[iVar12][0].z - bridge->pos[iVar14][0].z);
-                dVar18 = (bridge->pos[iVar12][0].z - bridge->pos[iVar14][0].z);
-                Bridges[iVar10].vel[2]->z = Bridges[iVar10].vel[2]->z +
-                     (((dVar20 * dVar18) * bridge->tension) * 0.5f + (dVar18 * bridge->tension));
-                dVar20 = NuFabs(bridge->pos[iVar13][1].x - bridge->pos[iVar14][1].x);
-                dVar18 = (bridge->pos[iVar13][1].x - bridge->pos[iVar14][1].x);
-                Bridges[iVar10].vel[3]->x =
-                     Bridges[iVar10].vel[3]->x + (((dVar20 * dVar18) * bridge->tension) * 0.5f + (dVar18 * bridge->tension));
-                dVar20 = NuFabs(bridge->pos[iVar13][1].y - bridge->pos[iVar14][1].y);
-                dVar18 = (bridge->pos[iVar13]->y - bridge->pos[iVar14]->y);
-                Bridges[iVar10].vel[3]->y = Bridges[iVar10].vel[3]->y + (((dVar20 * dVar18) *  bridge->tension) * 0.5f +
-                            (dVar18 * bridge->tension));
-                dVar20 = NuFabs(bridge->pos[iVar13][1].z - bridge->pos[iVar14][1].z);
-                //pfVar4 = &bridge->pos[iVar13][1].z;
-                //iVar13 = iVar13 + 0x18;
-                dVar18 = bridge->pos[iVar13][1].z - bridge->pos[iVar14][1].z;
-                Bridges[iVar10].vel[3]->z = Bridges[iVar10].vel[3]->z +
-                     (((dVar20 * dVar18) * bridge->tension) * 0.5f + (dVar18 * bridge->tension));
-                dVar20 = NuFabs(bridge->pos[iVar12][1].x - bridge->pos[iVar14][1].x);
-                dVar18 = bridge->pos[iVar12][1].x - bridge->pos[iVar14][1].x;
-                Bridges[iVar10].vel[3]->x = Bridges[iVar10].vel[3]->x +
-                     (((dVar20 * dVar18) * bridge->tension) * 0.5f + (dVar18 * bridge->tension));
-                dVar20 = NuFabs(bridge->pos[iVar12][1].y - bridge->pos[iVar14][1].y);
-                dVar18 = bridge->pos[iVar12][1].y - bridge->pos[iVar14][1].y;
-                Bridges[iVar10].vel[3]->y = Bridges[iVar10].vel[3]->y + (((dVar20 * dVar18) * bridge->tension) * 0.5f +
-                            (dVar18 * bridge->tension));
-                dVar20 = NuFabs(bridge->pos[iVar12][1].z - bridge->pos[iVar14][1].z);
-                //pfVar4 = &bridge->pos[iVar12][0].x;
-                //pfVar5 = &bridge->pos[iVar14][0].x;
-                //iVar12 = iVar12 + 0x18;
-                //iVar14 = iVar14 + 0x18;
-                dVar18 = (bridge->pos[iVar12][0].x - bridge->pos[iVar14][0].x);
-                Bridges[iVar10].vel[3]->z =
-                     Bridges[iVar10].vel[3]->z + (((dVar20 * dVar18) *  bridge->tension) * 0.5f +  (dVar18 * bridge->tension));
-                //bridgetmp = bridge2;
-              } //while (iVar10 < bridge->sections - 1);
-            //}
-            //if (1 < bridge->sections - 1) {
-              //dVar21 = 0.5f;
-              //iVar10 = 1;
-              for (iVar13 = 1; iVar13 < bridge->sections - 1; iVar13++) {
-                //iVar13 = iVar10 + 1;
-                //m_00 = &bridge->mtx[iVar13];
-                bridge->pos[iVar13][0].x = bridge->pos[iVar13][0].x + bridge->vel[iVar13][0].x;
-                bridge->pos[iVar13][0].y = bridge->pos[iVar13][0].y + bridge->vel[iVar13][0].y;
-                bridge->pos[iVar13][0].z = bridge->pos[iVar13][0].z + bridge->vel[iVar13][0].z;
-                bridge->pos[iVar13][1].x =
-                     bridge->pos[iVar13][1].x + bridge->vel[iVar13][1].x;
-                bridge->pos[iVar13][1].y =
-                     bridge->pos[iVar13][1].y + bridge->vel[iVar13][1].y;
-                bridge->pos[iVar13][1].z =
-                     bridge->pos[iVar13][1].z + bridge->vel[iVar13][1].z;
-                NuMtxSetRotationY(&bridge->mtx[iVar13],(s32)bridge->yang);
-                fVar22 = bridge->pos[iVar13][1].z - bridge->pos[iVar13][0].z;
-                fVar24 = bridge->pos[iVar13][1].x - bridge->pos[iVar13][0].x;
-                fVar22 = NuFsqrt(fVar24 * fVar24 + fVar22 * fVar22);
-                iVar12 = NuAtan2D(bridge->pos[iVar13][1].y - bridge->pos[iVar13][0].y,fVar22);
-                NuMtxPreRotateX(&bridge->mtx[iVar13],iVar12);
-                fVar22 = ((bridge->pos[iVar13][2].z + bridge->pos[iVar13][3].z) -
-                        (bridge->pos[iVar10]->x)) - (bridge->pos[iVar10]->x);
-                fVar24 = ((bridge->pos[iVar13][2].x + bridge->pos[iVar13][3].x) -
-                         bridge->pos[20][iVar10].y) -
-                         bridge->pos[21][iVar10].y;
-                fVar22 = NuFsqrt(fVar24 * fVar24 + fVar22 * fVar22);
-                iVar12 = NuAtan2D(((bridge->pos[iVar13][2].y + bridge->pos[iVar13][3].y)
-                                  - bridge->pos[20][iVar10].z) - bridge->pos[22][iVar10].y,fVar22);
-                NuMtxPreRotateZ(&bridge->mtx[iVar13],iVar12);
-                bridge->mtx[iVar10]._30 =
-                     ((bridge->pos[iVar13][0].x + bridge->pos[iVar13][1].x) * 0.5f);
-                bridge->mtx[iVar10]._31 =
-                     ((bridge->pos[iVar13][0].y + bridge->pos[iVar13][1].y) * 0.5f);
-                bridge->mtx[iVar10]._32 =
-                     ((bridge->pos[iVar13][0].z + bridge->pos[iVar13][1].z) * 0.5f);
-                iVar10 = iVar13;
-              } //while (iVar13 < bridge->sections - 1);
-            //}
-            NuMtxSetRotationY(&bridge->mtx[0],(s32)bridge->yang);
-            fVar22 = bridge->pos[1]->z - bridge->pos[0]->z;
-            fVar24 = bridge->pos[1]->x - bridge->pos[0]->x;
-            fVar22 = NuFsqrt(fVar24 * fVar24 + fVar22 * fVar22);
-            iVar10 = NuAtan2D(bridge->pos[1]->y - bridge->pos[0]->y,fVar22);
-            NuMtxPreRotateX(&bridge->mtx[0],iVar10);
-            fVar22 = ((bridge->pos[2]->z + bridge->pos[3]->z) - bridge->pos[0]->z) - bridge->pos[1]->z;
-            fVar24 = ((bridge->pos[2]->x + bridge->pos[3]->x) - bridge->pos[0]->x) - bridge->pos[1]->x;
-            fVar23 = NuFsqrt(fVar24 * fVar24 + fVar22 * fVar22);
-            fVar22 = bridge->pos[2]->y;
-            fVar24 = bridge->pos[3]->y;
-            dVar21 = ((bridge->pos[0]->y + bridge->pos[1]->y + fVar22 + fVar24) * 0.25f);
-            iVar10 = NuAtan2D((fVar22 + fVar24) - (dVar21 + dVar21),fVar23);
-            NuMtxPreRotateZ(&bridge->mtx[0],iVar10);
-            //fVar22 = bridge->pos[1]->x;
-            //fVar24 = bridge->pos[1]->z;
-            //fVar23 = bridge->pos[0]->x;
-            //fVar2 = bridge->pos[0]->z;
-            bridge->mtx[0]._31 = dVar21;
-            bridge->mtx[0]._30 = ((bridge->pos[0]->x + bridge->pos[1]->x) * 0.5f);
-            bridge->mtx[0]._32 = ((bridge->pos[0]->z + bridge->pos[1]->z) * 0.5f);
-            NuMtxSetRotationY(bridge->mtx + bridge->sections - 1,bridge->yang);
-            iVar10 = (s32)bridge->sections;
-            fVar22 = bridge->pos[iVar10][15].x - bridge->pos[iVar10][10].x;
-            fVar24 = bridge->pos[17][iVar10].y - bridge->pos[16][iVar10].y;
-            fVar22 = NuFsqrt(fVar24 * fVar24 + fVar22 * fVar22);
-            iVar10 = NuAtan2D(bridge->pos[20][iVar10].y - bridge->pos[18][bridge->sections].y, fVar22);
-            NuMtxPreRotateX(&bridge->mtx[0],iVar10);
-            iVar10 = (s32)bridge->sections;
-            fVar22 = ((bridge->pos[21][iVar10].x + bridge->pos[22][iVar12].x) -
-                     bridge->pos[iVar10][10].x) - bridge->pos[iVar10][15].x;
-            fVar24 = ((bridge->pos[20][iVar10].y +
-                      bridge->pos[21][iVar10].y) - bridge->pos[16][iVar10].y) - bridge->pos[17][iVar10].y;
-            fVar24 = NuFsqrt(fVar24 * fVar24 + fVar22 * fVar22);
-            iVar12 = (s32)bridge->sections;
-            fVar22 = bridge->pos[22][iVar12].x + bridge->pos[22][iVar12].y;
-            dVar21 = ((fVar22 + bridge->pos[18][iVar12].y + bridge->pos[20][iVar10].y) * 0.25f);
-            iVar10 = NuAtan2D(fVar22 - (dVar21 + dVar21),fVar24);
-            NuMtxPreRotateZ(bridge->mtx + iVar12 - 1,iVar10);
-            iVar10 = (s32)bridge->sections;
-            bridge->mtx[iVar10 - 1]._30 = ((bridge->pos[20][iVar10].y +  bridge->pos[21][iVar10].y) * 0.5f);
-            bridge->mtx[bridge->sections - 1]._31 = dVar21;
-            iVar10 = (s32)bridge->sections;
-            bridge->mtx[iVar10 - 1]._32 = ((bridge->pos[20][iVar10].z + bridge->pos[21][iVar10].z) * 0.5f);
-          }
-        }
-        else {
-          bridge->inrange = 0;
+            } else {
+                bridge->still = 0;
+            }
+            NuBridgeBuildMtx(bridge);
         }
-        //i = i + 1;
-        bridge++;
-      } //while (i < BridgeFree);
-    //}
-  }
-  return;
-}
\ No newline at end of file
+    }
+    return;
+}
@@ -8,8 +8,48 @@ s32 NuWindRand(void) {
   return NuWindQS;
 }
 
-//NGC MATCH
+s32 NuWindBatchEnabled = 0;
+float NuWindLodNear = 4.0f;
+float NuWindLodFar = 10.0f;
+
+static struct nuwindbatch_s NuWindBatch[64];
+
+static void NuWindBatchFree(struct nuwindbatch_s* b) {
+    struct nugeom_s* geom;
+    struct nugeom_s* next;
+    s32 k;
+
+    if (b->gobj != NULL) {
+        // a failed build leaves some of these missing
+        for (geom = b->gobj->geom; geom != NULL; geom = next) {
+            next = geom->next;
+            if (geom->prim != NULL) {
+                if (geom->prim->idxbuff != 0) {
+                    GS_DeleteBuffer((void*)geom->prim->idxbuff);
+                }
+                free(geom->prim);
+            }
+            if (geom->hVB != 0) {
+                GS_DeleteBuffer((void*)geom->hVB);
+            }
+            free(geom);
+        }
+        free(b->gobj);
+    }
+    for (k = 0; k < b->nmtl; k++) {
+        free(b->blade[k]);
+    }
+    free(b->order);
+    memset(b, 0, sizeof(struct nuwindbatch_s));
+}
+
 void NuWindInit(void) {
+  s32 i;
+
+  // the groups are about to be reused, and the batches point at the old scene's materials
+  for (i = 0; i < 64; i++) {
+    NuWindBatchFree(&NuWindBatch[i]);
+  }
   NuWindDir = 0;
   NuWindDir2 = 0;
   NuWindWave = 0;
@@ -49,39 +89,388 @@ void NuWindFreeMtxs(struct numtx_s *mtx,s32 count) {
    }
 }
 
-//NGC MATCH
-void NuWindDraw(struct nugscn_s *scn) {
-    s32 lp;
+// Work out which material slot each geom of proto goes to, returns 0 if proto can't be batched.
+static s32 NuWindBatchCount(struct nugobj_s* proto, struct numtl_s** mtl, s32* nvtx, s32* nidx) {
+    struct nugobj_s* gobj;
+    struct nugeom_s* geom;
+    struct nuprim_s* prim;
+    s32 nmtl;
+    s32 n;
+    s32 k;
+
+    nmtl = 0;
+    for (gobj = proto; gobj != NULL; gobj = gobj->next_gobj) {
+        if ((gobj->type != NUGOBJ_MESH) || (gobj->faceon_geom != NULL)) {
+            return 0;
+        }
+        for (geom = gobj->geom; geom != NULL; geom = geom->next) {
+            if ((geom->vtxtype != NUVT_TC1) || (geom->hVB == 0) || (geom->skin != NULL) || (geom->vtxskininfo != NULL)
+                || (geom->blendgeom != NULL)) {
+                return 0;
+            }
+            for (k = 0; (k < nmtl) && (mtl[k] != geom->mtl); k++) {}
+            if (k == nmtl) {
+                if (nmtl == NUWIND_BATCHMTLS) {
+                    return 0;
+                }
+                mtl[k] = geom->mtl;
+                nvtx[k] = 0;
+                nidx[k] = 0;
+                nmtl++;
+            }
+            nvtx[k] += geom->vtxcnt;
+            for (prim = geom->prim; prim != NULL; prim = prim->next) {
+                n = NuPrimTriListSize(geom, prim);
+                if (n < 0) {
+                    return 0;
+                }
+                nidx[k] += n;
+            }
+        }
+    }
+    return nmtl;
+}
+
+// Build the batch for grp, every blade gets its own copy of the verts and the indices never change.
+static void NuWindBatchBuild(struct nuwindbatch_s* b, struct nuwindgrp_s* grp, struct nugobj_s* proto, u32 seed) {
+    struct numtl_s* mtl[NUWIND_BATCHMTLS];
+    s32 nvtx[NUWIND_BATCHMTLS];
+    s32 nidx[NUWIND_BATCHMTLS];
+    u16* out[NUWIND_BATCHMTLS];
+    struct nugobj_s* gobj;
+    struct nugeom_s* geom;
+    struct nugeom_s* dst;
+    struct nuprim_s* prim;
+    struct nuvtx_tc1_s* src;
+    struct nuvtx_tc1_s* vtx;
+    struct numtx_s* mtx;
+    struct nuvec_s min;
+    struct nuvec_s max;
+    struct nuvec_s c;
+    u16* idx;
+    float reach;
+    float scale;
+    float d;
+    s32 perblade;
+    s32 nmtl;
+    s32 n;
+    s32 i;
+    s32 j;
+    s32 k;
+
+    NuWindBatchFree(b);
+    b->proto = proto;
+    n = grp->objcount;
+    nmtl = NuWindBatchCount(proto, mtl, nvtx, nidx);
+    if ((nmtl == 0) || (n < 1)) {
+        return;
+    }
+    // the indices are u16, too many blades and the clump is drawn the old way
+    for (k = 0; k < nmtl; k++) {
+        if ((nvtx[k] * n > 0xffff) || (nidx[k] * n > 0xffff)) {
+            return;
+        }
+    }
+    b->nmtl = nmtl;
+
+    // anything that can't be allocated leaves b->gobj NULL, and the clump is drawn blade by blade
+    b->gobj = (struct nugobj_s*)malloc(sizeof(struct nugobj_s));
+    if (b->gobj == NULL) {
+        NuWindBatchFree(b);
+        return;
+    }
+    memset(b->gobj, 0, sizeof(struct nugobj_s));
+    for (k = 0; k < b->nmtl; k++) {
+        dst = (struct nugeom_s*)malloc(sizeof(struct nugeom_s));
+        if (dst == NULL) {
+            NuWindBatchFree(b);
+            return;
+        }
+        memset(dst, 0, sizeof(struct nugeom_s));
+        NuGobjAddGeom(b->gobj, dst);
+        dst->mtl = mtl[k];
+        dst->vtxtype = NUVT_TC1;
+        dst->hVB = (s32)GS_CreateBuffer(nvtx[k] * n * sizeof(struct nuvtx_tc1_s), 1);
+        dst->vtxmax = nvtx[k] * n;
+        dst->prim = (struct nuprim_s*)malloc(sizeof(struct nuprim_s));
+        if (dst->prim != NULL) {
+            memset(dst->prim, 0, sizeof(struct nuprim_s));
+            dst->prim->type = NUPT_NDXTRI;
+            dst->prim->idxbuff = (s32)GS_CreateBuffer(nidx[k] * n * 2, 2);
+        }
+        b->blade[k] = (struct nuvtx_tc1_s*)malloc(nvtx[k] * sizeof(struct nuvtx_tc1_s));
+        if ((dst->hVB == 0) || (dst->prim == NULL) || (dst->prim->idxbuff == 0) || (b->blade[k] == NULL)) {
+            NuWindBatchFree(b);
+            return;
+        }
+        out[k] = (u16*)dst->prim->idxbuff;
+        b->bladevtx[k] = 0;
+    }
+
+    // one blade, as NuRndrGrassGobj would have drawn it with an identity matrix, it doesn't add split origins either
+    reach = 0.0f;
+    for (gobj = proto; gobj != NULL; gobj = gobj->next_gobj) {
+        c = gobj->bounding_box_center;
+        d = NuFsqrt(c.x * c.x + c.y * c.y + c.z * c.z) + gobj->bounding_radius_from_center;
+        if (d > reach) {
+            reach = d;
+        }
+        for (geom = gobj->geom; geom != NULL; geom = geom->next) {
+            for (k = 0; mtl[k] != geom->mtl; k++) {}
+            for (prim = geom->prim; prim != NULL; prim = prim->next) {
+                out[k] = NuPrimTriList(out[k], geom, prim, b->bladevtx[k]);
+            }
+            src = (struct nuvtx_tc1_s*)geom->hVB;
+            vtx = b->blade[k] + b->bladevtx[k];
+            for (j = 0; j < geom->vtxcnt; j++, src++, vtx++) {
+                *vtx = *src;
+            }
+            b->bladevtx[k] += geom->vtxcnt;
+        }
+    }
+
+    // the rest of the blades reuse the first one's indices, offset to their own verts
+    for (dst = b->gobj->geom, k = 0; dst != NULL; dst = dst->next, k++) {
+        idx = (u16*)dst->prim->idxbuff;
+        perblade = out[k] - idx;
+        for (i = 1; i < n; i++) {
+            for (j = 0; j < perblade; j++) {
+                idx[i * perblade + j] = (u16)(idx[j] + i * b->bladevtx[k]);
+            }
+        }
+        dst->prim->max = (u16)(perblade * n);
+    }
+
+    b->order = (u16*)malloc(n * sizeof(u16));
+    if (b->order == NULL) {
+        NuWindBatchFree(b);
+        return;
+    }
+    for (i = 0; i < n; i++) {
+        b->order[i] = (u16)i;
+    }
+    for (i = n - 1; i > 0; i--) {
+        seed = seed * 0x41c64e6d + 0x3039;
+        j = (seed >> 16) % (i + 1);
+        k = b->order[i];
+        b->order[i] = b->order[j];
+        b->order[j] = (u16)k;
+    }
+
+    // blades lean up to about their own height, allow twice the unbent size around each root
+    mtx = grp->mtx;
+    min = max = *(struct nuvec_s*)&mtx->_30;
+    scale = 0.0f;
+    for (i = 0; i < n; i++, mtx++) {
+        if (mtx->_30 < min.x) {
+            min.x = mtx->_30;
+        }
+        if (mtx->_31 < min.y) {
+            min.y = mtx->_31;
+        }
+        if (mtx->_32 < min.z) {
+            min.z = mtx->_32;
+        }
+        if (mtx->_30 > max.x) {
+            max.x = mtx->_30;
+        }
+        if (mtx->_31 > max.y) {
+            max.y = mtx->_31;
+        }
+        if (mtx->_32 > max.z) {
+            max.z = mtx->_32;
+        }
+        d = NuFsqrt(mtx->_00 * mtx->_00 + mtx->_02 * mtx->_02);
+        if (d > scale) {
+            scale = d;
+        }
+    }
+    b->centre.x = (min.x + max.x) * 0.5f;
+    b->centre.y = (min.y + max.y) * 0.5f;
+    b->centre.z = (min.z + max.z) * 0.5f;
+    NuVecSub(&c, &max, &b->centre);
+    b->radius = NuFsqrt(c.x * c.x + c.y * c.y + c.z * c.z) + reach * scale * 2.0f;
+}
+
+// Write the first count blades of the shuffled order into the batch's vertex buffers.
+static void NuWindBatchFill(struct nuwindbatch_s* b, struct nuwindgrp_s* grp, s32 count) {
+    struct nugeom_s* geom;
+    struct nuvtx_tc1_s* src;
+    struct nuvtx_tc1_s* vtx;
+    struct numtx_s* m;
+    struct nuvec_s n0;
+    struct nuvec_s n1;
+    struct nuvec_s n2;
+    float inv;
     s32 i;
+    s32 j;
+    s32 k;
+
+    for (i = 0; i < count; i++) {
+        m = &grp->mtx[b->order[i]];
+        // normals take the inverse transpose, as GS_SetLightingMatrix does for a blade's own matrix
+        n0.x = m->_11 * m->_22 - m->_12 * m->_21;
+        n0.y = m->_12 * m->_20 - m->_10 * m->_22;
+        n0.z = m->_10 * m->_21 - m->_11 * m->_20;
+        n1.x = m->_21 * m->_02 - m->_22 * m->_01;
+        n1.y = m->_22 * m->_00 - m->_20 * m->_02;
+        n1.z = m->_20 * m->_01 - m->_21 * m->_00;
+        n2.x = m->_01 * m->_12 - m->_02 * m->_11;
+        n2.y = m->_02 * m->_10 - m->_00 * m->_12;
+        n2.z = m->_00 * m->_11 - m->_01 * m->_10;
+        inv = m->_00 * n0.x + m->_01 * n0.y + m->_02 * n0.z;
+        inv = (NuFabs(inv) > 0.000001f) ? (1.0f / inv) : 1.0f;
+        for (geom = b->gobj->geom, k = 0; geom != NULL; geom = geom->next, k++) {
+            src = b->blade[k];
+            vtx = (struct nuvtx_tc1_s*)geom->hVB + i * b->bladevtx[k];
+            // the sway is the lean in row 1, so it's applied to each vert by its height
+            for (j = 0; j < b->bladevtx[k]; j++, src++, vtx++) {
+                vtx->pnt.x = src->pnt.x * m->_00 + src->pnt.y * m->_10 + src->pnt.z * m->_20 + m->_30;
+                vtx->pnt.y = src->pnt.x * m->_01 + src->pnt.y * m->_11 + src->pnt.z * m->_21 + m->_31;
+                vtx->pnt.z = src->pnt.x * m->_02 + src->pnt.y * m->_12 + src->pnt.z * m->_22 + m->_32;
+                vtx->nrm.x = (src->nrm.x * n0.x + src->nrm.y * n1.x + src->nrm.z * n2.x) * inv;
+                vtx->nrm.y = (src->nrm.x * n0.y + src->nrm.y * n1.y + src->nrm.z * n2.y) * inv;
+                vtx->nrm.z = (src->nrm.x * n0.z + src->nrm.y * n1.z + src->nrm.z * n2.z) * inv;
+                vtx->diffuse = src->diffuse;
+                vtx->tc[0] = src->tc[0];
+                vtx->tc[1] = src->tc[1];
+            }
+        }
+    }
+    for (geom = b->gobj->geom, k = 0; geom != NULL; geom = geom->next, k++) {
+        geom->vtxcnt = count * b->bladevtx[k];
+        geom->prim->cnt = (u16)(count * (geom->prim->max / grp->objcount));
+    }
+}
+
+void NuWindBatchBuildAll(struct nugscn_s* scn) {
+    struct nuwindgrp_s* grp;
+    s32 lp;
+
+    grp = &NuWindGroup[0];
+    for (lp = 0; lp < NuWindGCount; lp++, grp++) {
+        if ((NuWindBatchEnabled == 0) || (grp->instance == NULL) || (scn == NULL)) {
+            NuWindBatchFree(&NuWindBatch[lp]);
+            continue;
+        }
+        NuWindBatchBuild(&NuWindBatch[lp], grp, scn->gobjs[grp->instance->objid], lp + 1);
+    }
+}
+
+// The old way, a NuRndrGrassGobj call per blade.
+static void NuWindDrawBlades(struct nuwindgrp_s* grp, struct nugobj_s* gobj) {
+    struct numtx_s* mtx;
     float t2;
     float t3;
-    struct nuwindgrp_s *grp;
-    struct numtx_s *mtx;
-    struct nugobj_s *gobj;
-    char pad[25];
-    
+    s32 i;
+
+    mtx = grp->mtx;
+    for (i = 0; i < grp->objcount; i++) {
+        t2 = mtx->_23;
+        t3 = mtx->_33;
+        mtx->_23 = 0.0f;
+        mtx->_33 = 1.0f;
+        if (NuRndrGrassGobj(gobj, mtx, NULL) != 0) {
+            grp->onscreen = '\x01';
+        }
+        mtx->_23 = t2;
+        mtx->_33 = t3;
+        mtx++;
+    }
+}
+
+// Cull every batched clump in one pass, then draw each survivor as one batch thinned by its distance.
+void NuWindDraw(struct nugscn_s *scn) {
+    static float cx[64];
+    static float cy[64];
+    static float cz[64];
+    static float cr[64];
+    static float dist2[64];
+    static s32 grpix[64];
+    struct nuclipspheres_s spheres;
+    struct nuwindbatch_s* b;
+    struct nuwindgrp_s* grp;
+    struct nugobj_s* gobj;
+    struct numtx_s ident;
+    u32 inside[2];
+    u32 cross[2];
+    u32 distant[2];
+    nuf4 dx;
+    nuf4 dy;
+    nuf4 dz;
+    nuf4 lim;
+    float d;
+    s32 count;
+    s32 n;
+    s32 lp;
+    s32 i;
+
+    n = 0;
     grp = &NuWindGroup[0];
-    for (lp = 0; lp < NuWindGCount; lp++) {
-            if (grp->inrange != '\0') {
-                grp->onscreen = '\0';
-                mtx = grp->mtx;
-                gobj = scn->gobjs[grp->instance->objid];
-                    for (i = 0; i < grp->objcount; i++) {
-                        t2 = mtx->_23;
-                        t3 = mtx->_33;
-                        mtx->_23 = 0.0f;
-                        mtx->_33 = 1.0f;
-                        if (NuRndrGrassGobj(gobj,mtx,NULL) != 0) {
-                            grp->onscreen = '\x01';
-                        }
-                        mtx->_23 = t2;
-                        mtx->_33 = t3;
-                        mtx++;
-                    }
-            }
-            grp++;
+    for (lp = 0; lp < NuWindGCount; lp++, grp++) {
+        if ((grp->inrange == '\0') || (grp->instance == NULL)) {
+            continue;
+        }
+        grp->onscreen = '\0';
+        gobj = scn->gobjs[grp->instance->objid];
+        b = &NuWindBatch[lp];
+        // batches are built by NuWindBatchBuildAll at level load, anything without one is drawn blade by blade
+        if ((NuWindBatchEnabled != 0) && (b->proto == gobj) && (b->gobj != NULL)) {
+            cx[n] = b->centre.x;
+            cy[n] = b->centre.y;
+            cz[n] = b->centre.z;
+            cr[n] = b->radius;
+            grpix[n] = lp;
+            n++;
+            continue;
+        }
+        NuWindDrawBlades(grp, gobj);
+    }
+    if (n == 0) {
+        return;
+    }
+
+    spheres.x = cx;
+    spheres.y = cy;
+    spheres.z = cz;
+    spheres.radius = cr;
+    NuCameraClipTestBoundingSpheres(&spheres, n, inside, cross, NULL);
+    // anything past NuWindLodFar from the camera has thinned out to nothing
+    distant[0] = 0;
+    distant[1] = 0;
+    for (i = 0; i < n; i += 4) {
+        dx = NuF4Sub(NuF4LoadU(&cx[i]), NuF4Set1(global_camera.mtx._30));
+        dy = NuF4Sub(NuF4LoadU(&cy[i]), NuF4Set1(global_camera.mtx._31));
+        dz = NuF4Sub(NuF4LoadU(&cz[i]), NuF4Set1(global_camera.mtx._32));
+        dx = NuF4Madd(dx, dx, NuF4Madd(dy, dy, NuF4Mul(dz, dz)));
+        lim = NuF4Add(NuF4LoadU(&cr[i]), NuF4Set1(NuWindLodFar));
+        distant[i >> 5] |= (u32)NuF4MaskBits(NuF4CmpLt(NuF4Mul(lim, lim), dx)) << (i & 0x1f);
+        NuF4StoreU(&dist2[i], dx);
+    }
+
+    NuMtxSetIdentity(&ident);
+    for (i = 0; i < n; i++) {
+        if (((distant[i >> 5] >> (i & 0x1f)) & 1) != 0) {
+            continue;
+        }
+        if ((((inside[i >> 5] | cross[i >> 5]) >> (i & 0x1f)) & 1) == 0) {
+            continue;
+        }
+        grp = &NuWindGroup[grpix[i]];
+        b = &NuWindBatch[grpix[i]];
+        d = NuFsqrt(dist2[i]) - cr[i];
+        if (d <= NuWindLodNear) {
+            count = grp->objcount;
+        } else {
+            count = (s32)(grp->objcount * (NuWindLodFar - d) / (NuWindLodFar - NuWindLodNear) + 0.5f);
+        }
+        if (count < 1) {
+            continue;
+        }
+        grp->onscreen = '\x01';
+        NuWindBatchFill(b, grp, count);
+        NuRndrGrassBatch(b->gobj, &ident, (((inside[i >> 5] >> (i & 0x1f)) & 1) != 0) ? 1 : 2);
     }
-    return;
 }
 
 //NGC MATCH // PS2 MATCH
@@ -19,6 +19,32 @@ struct nuwindgrp_s
     float radius; // Offset: 0x24, DWARF: 0x759EFC
 }; 
 
+#define NUWIND_BATCHMTLS 4
+
+// One clump drawn as a single batch, see NuWindDraw.
+// Size: 0x40
+struct nuwindbatch_s
+{
+    struct nugobj_s* proto; // grass gobj it was built from
+    struct nugobj_s* gobj; // one indexed triangle list geom per material, NULL if proto can't be batched
+    s32 nmtl;
+    struct nuvtx_tc1_s* blade[NUWIND_BATCHMTLS]; // one blade's verts for each geom
+    s32 bladevtx[NUWIND_BATCHMTLS];
+    u16* order; // blades shuffled, drawing the first n of them thins the clump evenly
+    struct nuvec_s centre;
+    float radius;
+};
+
+// Draw each clump as one batch, 0 (the default) draws per blade. Off until the batch is timed against it on hardware.
+extern s32 NuWindBatchEnabled;
+
+// Build a batch for every clump from scn's gobjs, call once the clumps are created.
+void NuWindBatchBuildAll(struct nugscn_s* scn);
+
+// Clumps are drawn in full up to NuWindLodNear from the camera and thin out to nothing at NuWindLodFar.
+extern float NuWindLodNear;
+extern float NuWindLodFar;
+
 s32 NuWindGCount;
 struct nuwindgrp_s NuWindGroup[64];
 struct numtx_s NuWindMtxs[512];
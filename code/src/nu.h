@@ -6,6 +6,7 @@
 #include "numath.h"
 #include "nuraster.h"
 #include "nusound.h"
+#include "nuxbox/nuscratch.h"
 
 
 #endif // !NU_H
@@ -275,7 +275,16 @@ struct nufaceon_s
     int colour;
 };
 
-// Size: 0x40
+// One blend's offsets, kept only for the blocks of 4 vertices it moves.
+// Size: 0xC
+struct NUBLENDTARGET_s
+{
+    int nblocks;
+    int* block;
+    float* delta; // x4 y4 z4 for each block
+};
+
+// Size: 0x58
 struct NUBLENDGEOM_s
 {
     int nblends;
@@ -285,6 +294,12 @@ struct NUBLENDGEOM_s
     struct nuvec_s* ooffsets;
     int hVB; //VertexBuffer, GS_Buffer * ?
     int blendindex[10];
+    struct NUBLENDTARGET_s* targets;
+    float* base;      // source positions in blocks of 4, x4 y4 z4
+    float* acc;       // blended positions, same layout
+    float* lastvals;  // weights hVB was last built with
+    int nblocks;
+    int cached;
 };
 
 // Size: 0x18
@@ -460,7 +475,7 @@ struct nuscene_s
 	struct nugscn_s* gscene;
 };
 
-// Size: 0x74
+// Size: 0x80
 struct nugscn_s
 {
 	short* tids;
@@ -493,6 +508,9 @@ struct nugscn_s
 	struct nutexanim_s* texanims;
 	short* texanim_tids;
 	short* instancelightix;
+	char** ixnames;                 // spline names then special names, for the indices below
+	struct nunameix_s* splineix;    // NULL until NuGScnBuildNameIndex
+	struct nunameix_s* specialix;
 };
 
 // Size: 0xC
@@ -567,7 +585,8 @@ struct nuinstanim_s
 	unsigned int waiting : 1; // Offset: 0x50, Bit Offset: 2, Bit Size: 1
 	unsigned int repeating : 1; // Offset: 0x50, Bit Offset: 3, Bit Size: 1
 	unsigned int oscillate : 1; // Offset: 0x50, Bit Offset: 4, Bit Size: 1
-	int ipad[2]; // Offset: 0x54
+	float evaltime; // Offset: 0x54, ltime the rotation and scale in mtx were built for (file padding)
+	int evalvalid; // Offset: 0x58
 	unsigned char anim_ix;
 	char pad[3];
 };
@@ -450,76 +450,62 @@ void NuAnimData2CalcTime(struct nuanimdata2_s *animdata,float time,struct nuanim
     return;
 }
 
-//NGC 97%
-float NuAnimCurve2CalcVal(struct nuanimcurve2_s* animcurve, struct nuanimtime_s* atime, enum NUANIMKEYTYPES_e keytype)
+#if defined(_MSC_VER)
+static inline u32 NuAnimPopCount32(u32 v)
+{
+    v = v - ((v >> 1) & 0x55555555);
+    v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+    return (((v + (v >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24;
+}
+#else
+#define NuAnimPopCount32(v) ((u32)__builtin_popcount(v))
+#endif
+
+// Bits of a chunk mask up to and including the frame atime sits on.
+// The mask is stored as 32 frame bits in byte order, so the word is built from the bytes.
+static inline u32 NuAnimTimeBits(struct nuanimtime_s* atime)
 {
+    u32 shift = atime->time_byte * 8;
+
+    return ((1u << shift) - 1) | (atime->time_mask << shift);
+}
+
+static float NuAnimCurve2KeyVal(struct nuanimcurve2_s* animcurve, struct nuanimtime_s* atime,
+enum NUANIMKEYTYPES_e keytype, u32 timebits)
+{
+    struct nuanimcurvedata_s* curvedata;
     u8 *mask;
-    u32 chunk_start_ix;
-    u32 offset;
-    s32 poopoo;
+    u32 word;
+    s32 ix;
     struct NUANIMKEYBIG_s *nextkey;
     struct NUANIMKEYBIG_s *key;
     float val;
     float dt;
     float fVar8;
-    float fVar11;
     float time;
-    struct NUANIMKEYINTEGER_s* inextkey;
     struct NUANIMKEYINTEGER_s* ikey;
-    s32 frame;
-    u32 *ixtmp;
 
     if (keytype == NUANIMKEYTYPE_NONE) {
         return animcurve->data.constant;
     }
 
-    chunk_start_ix = atime->chunk;
-    //mask = &animcurve->data.curvedata->mask[chunk_start_ix];
-    mask = (u8*)&animcurve->data.curvedata->mask[chunk_start_ix];
+    curvedata = animcurve->data.curvedata;
+    mask = (u8*)&curvedata->mask[atime->chunk];
 
     if (keytype == NUANIMKEYTYPE_BOOLEAN) {
-        frame = floor(atime->time_offset); // gcc2_compiled__N108
-        frame--;
-        poopoo = 0;
-        if ((*(s32*)&mask[0] != 0) && (1 << frame)) {
-            poopoo = 1;
-        }
-        return poopoo;
+        // the original frame test is always true, so any key in the chunk turns it on
+        return (*(s32*)&mask[0] != 0) ? 1.0f : 0.0f;
     }
 
-    switch (atime->time_byte) {
-        case 0:
-            offset =  BitCountTable[mask[0] & atime->time_mask];
-            break;
-        case 1:
-            offset =  BitCountTable[mask[0]];
-            offset += BitCountTable[mask[1] & atime->time_mask];
-            break;
-        case 2:
-            offset =  BitCountTable[mask[0]];
-            offset += BitCountTable[mask[1]];
-            offset += BitCountTable[mask[2] & atime->time_mask];
-            break;
-        case 3:
-            offset =  BitCountTable[mask[0]];
-            offset += BitCountTable[mask[1]];
-            offset += BitCountTable[mask[2]];
-            offset += BitCountTable[mask[3] & atime->time_mask];
-            break;
-    }
+    word = mask[0] | (mask[1] << 8) | (mask[2] << 16) | ((u32)mask[3] << 24);
+
+    // key_ixs holds the keys before each chunk, the popcount adds the ones in it up to this frame
+    ix = (s32)curvedata->key_ixs[atime->chunk] + (s32)NuAnimPopCount32(word & timebits) - 1;
 
-    ixtmp = animcurve->data.curvedata->key_ixs[chunk_start_ix];
     switch(keytype) {
-        case NUANIMKEYTYPE_NONE:
-            NuErrorProlog("C:/source/crashwoc/code/nu3dx/nuanim.c",0xbbb)
-                ("NuAnimCurve2CalcVal: should have already evaluated NUANIMKEYTYPE_NONE");
-            break;
         case NUANIMKEYTYPE_BIG:
-            key = &((struct NUANIMKEYBIG_s *)animcurve->data.curvedata->key_array)[(s32)ixtmp + offset - 1];
+            key = &((struct NUANIMKEYBIG_s *)curvedata->key_array)[ix];
             nextkey = &key[1];
-            if(atime->time > key->val  || atime->time < key->time){
-                okdokey();
-            }
             val = key->val - nextkey->val;
             fVar8 = key->grad * (nextkey->time - key->time);
             dt = nextkey->grad * (nextkey->time - key->time);
@@ -530,19 +516,33 @@ float NuAnimCurve2CalcVal(struct nuanimcurve2_s* animcurve, struct nuanimtime_s*
                 ("NuAnimCurve2CalcVal: not supporting NUANIMKEYTYPE_SMALL yet");
             break;
         case NUANIMKEYTYPE_INTEGER:
-            ikey = &((struct NUANIMKEYINTEGER_s *)animcurve->data.curvedata->key_array)[(s32)ixtmp + offset - 1];
-            inextkey = &ikey[1];
-             if(atime->time > inextkey->time  || atime->time < ikey->time){
-                okdokey();
-            }
+            ikey = &((struct NUANIMKEYINTEGER_s *)curvedata->key_array)[ix];
             return ikey->val;
-        case NUANIMKEYTYPE_BOOLEAN:
-            NuErrorProlog("C:/source/crashwoc/code/nu3dx/nuanim.c",0xbec)
-                ("NuAnimCurve2CalcVal: should have already evaluated NUANIMKEYTYPE_BOOLEAN");
+        default:
+            break;
     }
     return 0.0f;
 }
 
+float NuAnimCurve2CalcVal(struct nuanimcurve2_s* animcurve, struct nuanimtime_s* atime, enum NUANIMKEYTYPES_e keytype)
+{
+    return NuAnimCurve2KeyVal(animcurve, atime, keytype, NuAnimTimeBits(atime));
+}
+
+void NuAnimCurve2SetCalcVals(struct nuanimcurve2_s* animcurveset, char* curveflags, u32 chanmask,
+struct nuanimtime_s* atime, float* vals)
+{
+    u32 timebits;
+    s32 i;
+
+    timebits = NuAnimTimeBits(atime);
+    for (i = 0; chanmask != 0; i++, chanmask >>= 1) {
+        if (chanmask & 1) {
+            vals[i] = NuAnimCurve2KeyVal(&animcurveset[i], atime, (int)curveflags[i], timebits);
+        }
+    }
+}
+
 
 //PS2
 void NuAnimCurve2SetApplyToJoint(struct nuanimcurve2_s* animcurveset, char* curveflags,
@@ -555,6 +555,8 @@ struct nuvec_s* scale, struct nuvec_s* parentscale, struct numtx_s* T, struct NU
     struct nuvec_s lo;
     struct nuangvec_s rf;
     struct nuvec_s inv_scale;
+    float vals[NUANIM_NUMMTXOPERATIONS];
+    u32 chanmask;
 
     if (offset != NULL) {
         procanim_flags = offset->flags;
@@ -563,11 +565,20 @@ struct nuvec_s* scale, struct nuvec_s* parentscale, struct numtx_s* T, struct NU
         procanim_flags = 0;
     }
 
+    chanmask = 7;
+    if (curvesetflags & 1) {
+        chanmask |= 0x38;
+    }
+    if (curvesetflags & 8) {
+        chanmask |= 0x1c0;
+    }
+    NuAnimCurve2SetCalcVals(animcurveset, curveflags, chanmask, atime, vals);
+
     if((curvesetflags & 1) || (procanim_flags & 1)) {
         if (curvesetflags & 1) {
-            r.x = NuAnimCurve2CalcVal(&animcurveset[3], atime, (int)curveflags[3]);
-            r.y = NuAnimCurve2CalcVal(&animcurveset[4], atime, (int)curveflags[4]);
-            r.z = NuAnimCurve2CalcVal(&animcurveset[5], atime, (int)curveflags[5]);
+            r.x = vals[NUANIM_X_ROTATION];
+            r.y = vals[NUANIM_Y_ROTATION];
+            r.z = vals[NUANIM_Z_ROTATION];
         } else {
             r.x = r.y = r.z = 0.0f;
         }
@@ -635,9 +646,9 @@ struct nuvec_s* scale, struct nuvec_s* parentscale, struct numtx_s* T, struct NU
 
     if((curvesetflags & 8) || (procanim_flags & 4)) {
         if (curvesetflags & 8) {
-            scale->x = NuAnimCurve2CalcVal(&animcurveset[6], atime, (int)curveflags[6]);
-            scale->y = NuAnimCurve2CalcVal(&animcurveset[7], atime, (int)curveflags[7]);
-            scale->z = NuAnimCurve2CalcVal(&animcurveset[8], atime, (int)curveflags[8]);
+            scale->x = vals[NUANIM_X_SCALE];
+            scale->y = vals[NUANIM_Y_SCALE];
+            scale->z = vals[NUANIM_Z_SCALE];
         } else {
             scale->x = scale->y = scale->z = 0.0f;
         }
@@ -666,9 +677,9 @@ struct nuvec_s* scale, struct nuvec_s* parentscale, struct numtx_s* T, struct NU
         scale->z *= inv_scale.z;
     }
 
-    t.x = NuAnimCurve2CalcVal(&animcurveset[0], atime, (int)curveflags[0]);
-    t.y = NuAnimCurve2CalcVal(&animcurveset[1], atime, (int)curveflags[1]);
-    t.z = NuAnimCurve2CalcVal(&animcurveset[2], atime, (int)curveflags[2]);
+    t.x = vals[NUANIM_X_TRANSLATION];
+    t.y = vals[NUANIM_Y_TRANSLATION];
+    t.z = vals[NUANIM_Z_TRANSLATION];
 
     if ((procanim_flags & 2U) != 0) {
         t.x += offset->tx;
@@ -1278,6 +1289,15 @@ void NuAnimCurveSetApplyBlendToJoint2
 }
 
 
+// The translation NuAnimCurveSetApplyToMatrix puts in the bottom row, z flipped like the rest of the matrix.
+void NuAnimCurveSetCalcTranslation(struct nuanimcurveset_s *animcurveset, struct nuanimtime_s *atime, struct nuvec_s *t)
+{
+  t->x = (animcurveset->set[0] != NULL) ? NuAnimCurveCalcVal2(animcurveset->set[0],atime) : animcurveset->constants[0];
+  t->y = (animcurveset->set[1] != NULL) ? NuAnimCurveCalcVal2(animcurveset->set[1],atime) : animcurveset->constants[1];
+  t->z = (animcurveset->set[2] != NULL) ? NuAnimCurveCalcVal2(animcurveset->set[2],atime) : animcurveset->constants[2];
+  t->z = -t->z;
+}
+
 //PS2 Match
 void NuAnimCurveSetApplyToMatrix (struct nuanimcurveset_s *animcurveset,struct nuanimtime_s *atime,struct numtx_s *T)
 {
@@ -1374,11 +1394,14 @@ struct nuanimtime_s *atime, struct numtx_s *T)
   struct nuvec_s local_90;
   struct nuangvec_s rf;
   struct nuvec_s local_70;
+  float vals[NUANIM_NUMMTXOPERATIONS];
 
+  NuAnimCurve2SetCalcVals(animcurveset, curveflags,
+                          7 | ((curvesetflags & 1U) ? 0x38 : 0) | ((curvesetflags & 8U) ? 0x1c0 : 0), atime, vals);
   if ((curvesetflags & 1U) != 0) {
-    local_90.x = NuAnimCurve2CalcVal(animcurveset + 3,atime,(int)curveflags[3]);
-    local_90.y = NuAnimCurve2CalcVal(animcurveset + 4,atime,(int)curveflags[4]);
-    local_90.z = NuAnimCurve2CalcVal(animcurveset + 5,atime,(int)curveflags[5]);
+    local_90.x = vals[3];
+    local_90.y = vals[4];
+    local_90.z = vals[5];
     rf.z = (s32)(local_90.z * 10430.378f);
     rf.x = (s32)(local_90.x * 10430.378f);
     rf.y = (s32)(local_90.y * 10430.378f);
@@ -1388,14 +1411,14 @@ struct nuanimtime_s *atime, struct numtx_s *T)
       NuMtxSetIdentity(T);
   }
   if ((curvesetflags & 8U) != 0) {
-    local_70.x = NuAnimCurve2CalcVal(animcurveset + 6,atime,(int)curveflags[6]);
-    local_70.y = NuAnimCurve2CalcVal(animcurveset + 7,atime,(int)curveflags[7]);
-    local_70.z = NuAnimCurve2CalcVal(animcurveset + 8,atime,(int)curveflags[8]);
+    local_70.x = vals[6];
+    local_70.y = vals[7];
+    local_70.z = vals[8];
     NuMtxPreScale(T,&local_70);
   }
-  local_a0.x = NuAnimCurve2CalcVal(animcurveset,atime,(int)*curveflags);
-  local_a0.y = NuAnimCurve2CalcVal(animcurveset + 1,atime,(int)curveflags[1]);
-  local_a0.z = NuAnimCurve2CalcVal(animcurveset + 2,atime,(int)curveflags[2]);
+  local_a0.x = vals[0];
+  local_a0.y = vals[1];
+  local_a0.z = vals[2];
   NuMtxTranslate(T,&local_a0);
   T->_02 = -T->_02;
   T->_12 = -T->_12;
@@ -1418,7 +1441,7 @@ struct nuvec_s *parentscale, struct numtx_s* T, struct NUJOINTANIM_s* offset)
   float tmp2;
   float tmp3;
   struct nuangvec_s rf;
-
+  float vals[NUANIM_NUMMTXOPERATIONS];
 
   if (offset != NULL) {
     procanim_flags = offset->flags;
@@ -1426,9 +1449,10 @@ struct nuvec_s *parentscale, struct numtx_s* T, struct NUJOINTANIM_s* offset)
   else {
         procanim_flags = 0;
     }
-  r.x = NuAnimCurve2CalcVal(animcurveset + 3,atime,(int)curveflags[3]);
-  r.y = NuAnimCurve2CalcVal(animcurveset + 4,atime,(int)curveflags[4]);
-  r.z = NuAnimCurve2CalcVal(animcurveset + 5,atime,(int)curveflags[5]);
+  NuAnimCurve2SetCalcVals(animcurveset, curveflags, 0x38, atime, vals);
+  r.x = vals[NUANIM_X_ROTATION];
+  r.y = vals[NUANIM_Y_ROTATION];
+  r.z = vals[NUANIM_Z_ROTATION];
   if (procanim_flags & 1U) {
     r.x += offset->rx;
     r.y += offset->ry;
@@ -207,4 +207,12 @@ struct nuanimtime_s
     u32 time_byte;
 };
 
+void NuAnimCurveSetCalcTranslation(struct nuanimcurveset_s* animcurveset, struct nuanimtime_s* atime, struct nuvec_s* t);
+
+float NuAnimCurve2CalcVal(struct nuanimcurve2_s* animcurve, struct nuanimtime_s* atime, enum NUANIMKEYTYPES_e keytype);
+
+// Evaluate every channel whose bit is set in chanmask (bit n is curve n of the set) into vals[n].
+void NuAnimCurve2SetCalcVals(struct nuanimcurve2_s* animcurveset, char* curveflags, u32 chanmask,
+struct nuanimtime_s* atime, float* vals);
+
 #endif // !NUANIM_H
@@ -1,6 +1,7 @@
 #include <nucore/numem.h>
 #include "nucamera.h"
 #include "numath/numtx.h"
+#include "numath/nusimd.h"
 
 static s32 clip_enable = 1;
 static struct nuvec_s cam_axes = { 1.0f, 1.0f, 1.0f };
@@ -399,3 +400,128 @@ static void SetProjectionMatrix(struct numtx_s* mtx, float fFOV, float fAspect,
     mtx->_32 = (-dVar5 * fNearPlane);
     return;
 }
+
+// Test four objects against the frustum planes. 'e' is the radius for spheres, for boxes it is projected onto each plane normal.
+static void NuCameraClipTest4(nuf4 cx, nuf4 cy, nuf4 cz, nuf4 ex, nuf4 ey, nuf4 ez, s32 isbox, s32 valid, u8* planecache, s32* outbits, s32* crossbits) {
+    struct nuvec4_s* p;
+    nuf4 zero;
+    nuf4 d;
+    nuf4 e;
+    nuf4mask out;
+    nuf4mask cross;
+    s32 start;
+    s32 rejected;
+    s32 k;
+    s32 i;
+
+    zero = NuF4Set1(0.0f);
+    out = NuF4CmpLt(zero, zero);
+    cross = out;
+    start = (planecache != NULL) ? *planecache : 0;
+    if (start > 5) {
+        start = 0;
+    }
+    rejected = -1;
+    for (k = 0; k < 6; k++) {
+        i = (start + k) % 6;
+        p = &frustrumplanes[i];
+        d = NuF4Madd(cx, NuF4Set1(p->x), NuF4Madd(cy, NuF4Set1(p->y), NuF4Madd(cz, NuF4Set1(p->z), NuF4Set1(p->w))));
+        if (isbox != 0) {
+            e = NuF4Madd(ex, NuF4Abs(NuF4Set1(p->x)), NuF4Madd(ey, NuF4Abs(NuF4Set1(p->y)), NuF4Mul(ez, NuF4Abs(NuF4Set1(p->z)))));
+        }
+        else {
+            e = ex;
+        }
+        out = NuF4MaskOr(out, NuF4CmpLt(NuF4Add(d, e), zero));
+        cross = NuF4MaskOr(cross, NuF4CmpLt(NuF4Sub(d, e), zero));
+        if ((rejected == -1) && ((NuF4MaskBits(out) & valid) != 0)) {
+            rejected = i;
+        }
+        if ((NuF4MaskBits(out) & valid) == valid) {
+            break;
+        }
+    }
+    if ((planecache != NULL) && (rejected != -1)) {
+        *planecache = (u8)rejected;
+    }
+    *outbits = NuF4MaskBits(out) & valid;
+    *crossbits = NuF4MaskBits(cross) & ~*outbits & valid;
+    return;
+}
+
+static s32 NuCameraClipTestBatch(f32** src, s32 isbox, s32 cnt, u32* inside, u32* cross, u8* planecache) {
+    f32 tail[6][4];
+    nuf4 v[6];
+    s32 outbits;
+    s32 crossbits;
+    s32 inbits;
+    s32 visible;
+    s32 valid;
+    s32 n;
+    s32 g;
+    s32 i;
+    s32 j;
+
+    memset(inside, 0, ((cnt + 31) >> 5) * sizeof(u32));
+    memset(cross, 0, ((cnt + 31) >> 5) * sizeof(u32));
+    if (clip_enable == 0) {
+        for (i = 0; i < cnt; i++) {
+            inside[i >> 5] |= (u32)1 << (i & 0x1f);
+        }
+        return cnt;
+    }
+
+    visible = 0;
+    for (g = 0; g * 4 < cnt; g++) {
+        n = cnt - g * 4;
+        if (n >= 4) {
+            for (j = 0; j < 6; j++) {
+                v[j] = (src[j] != NULL) ? NuF4LoadU(&src[j][g * 4]) : NuF4Set1(0.0f);
+            }
+            valid = 0xf;
+        }
+        else {
+            memset(tail, 0, sizeof(tail));
+            for (j = 0; j < 6; j++) {
+                for (i = 0; (src[j] != NULL) && (i < n); i++) {
+                    tail[j][i] = src[j][g * 4 + i];
+                }
+                v[j] = NuF4LoadU(tail[j]);
+            }
+            valid = (1 << n) - 1;
+        }
+        NuCameraClipTest4(v[0], v[1], v[2], v[3], v[4], v[5], isbox, valid, (planecache != NULL) ? &planecache[g] : NULL,
+                          &outbits, &crossbits);
+        inbits = valid & ~(outbits | crossbits);
+        inside[g >> 3] |= (u32)inbits << ((g & 7) * 4);
+        cross[g >> 3] |= (u32)crossbits << ((g & 7) * 4);
+        for (; valid != 0; valid >>= 1, outbits >>= 1) {
+            visible += ~outbits & 1;
+        }
+    }
+    return visible;
+}
+
+s32 NuCameraClipTestBoundingSpheres(struct nuclipspheres_s* spheres, s32 cnt, u32* inside, u32* cross, u8* planecache) {
+    f32* src[6];
+
+    src[0] = spheres->x;
+    src[1] = spheres->y;
+    src[2] = spheres->z;
+    src[3] = spheres->radius;
+    src[4] = NULL;
+    src[5] = NULL;
+    return NuCameraClipTestBatch(src, 0, cnt, inside, cross, planecache);
+}
+
+s32 NuCameraClipTestBoxes(struct nuclipboxes_s* boxes, s32 cnt, u32* inside, u32* cross, u8* planecache) {
+    f32* src[6];
+
+    src[0] = boxes->x;
+    src[1] = boxes->y;
+    src[2] = boxes->z;
+    src[3] = boxes->ex;
+    src[4] = boxes->ey;
+    src[5] = boxes->ez;
+    return NuCameraClipTestBatch(src, 1, cnt, inside, cross, planecache);
+}
@@ -24,6 +24,28 @@ enum nucamfxmode_s
     NUCAMFX_NONE = 0
 };
 
+// World space bounding spheres in SoA layout for the batched clip tests.
+// Size: 0x10
+struct nuclipspheres_s
+{
+    f32* x; // Offset: 0x0
+    f32* y; // Offset: 0x4
+    f32* z; // Offset: 0x8
+    f32* radius; // Offset: 0xC
+};
+
+// World space boxes in SoA layout (centre and half size) for the batched clip tests.
+// Size: 0x18
+struct nuclipboxes_s
+{
+    f32* x; // Offset: 0x0
+    f32* y; // Offset: 0x4
+    f32* z; // Offset: 0x8
+    f32* ex; // Offset: 0xC
+    f32* ey; // Offset: 0x10
+    f32* ez; // Offset: 0x14
+};
+
 // Global camera.
 extern struct nucamera_s global_camera;
 
@@ -107,6 +129,17 @@ struct numtx_s* NuCameraGetVPCSMtx();
 
 // NuCameraClipTestPoints
 
+/*
+  Batched frustum tests, four objects per step.
+  Results are bit arrays of (cnt + 31) / 32 words, one bit per object: set in 'inside' when the object is fully
+  inside all six planes, set in 'cross' when it straddles one, clear in both when it is culled.
+  'planecache' is optional, one byte per group of four objects ((cnt + 3) / 4), holding the plane that last rejected
+  the group so it is tested first next frame. Zero it once before first use.
+  Returns the number of objects not culled.
+*/
+s32 NuCameraClipTestBoundingSpheres(struct nuclipspheres_s* spheres, s32 cnt, u32* inside, u32* cross, u8* planecache);
+s32 NuCameraClipTestBoxes(struct nuclipboxes_s* boxes, s32 cnt, u32* inside, u32* cross, u8* planecache);
+
 // Get the squared distance from the camera to the point.
 f32 NuCameraDistSqr(struct nuvec_s* point);
 
@@ -474,6 +474,64 @@ void NuPrimDestroy(struct nuprim_s* prim) {
 	return;
 }
 
+// Triangle list indices the prim unrolls to at most, -1 if it isn't made of triangles.
+s32 NuPrimTriListSize(struct nugeom_s* geom, struct nuprim_s* prim) {
+    switch (prim->type) {
+        case NUPT_NDXTRI:
+            return prim->cnt;
+        case NUPT_NDXTRISTRIP:
+            return (prim->cnt > 2) ? (prim->cnt - 2) * 3 : 0;
+        case NUPT_TRI:
+            return geom->vtxcnt;
+        case NUPT_TRISTRIP:
+            return (geom->vtxcnt > 2) ? (geom->vtxcnt - 2) * 3 : 0;
+        default:
+            return -1;
+    }
+}
+
+// Append the prim to out as a triangle list with base added to each index, strips are unrolled with alternating winding and degenerates dropped.
+u16* NuPrimTriList(u16* out, struct nugeom_s* geom, struct nuprim_s* prim, s32 base) {
+    u16* idx;
+    s32 n;
+    s32 i;
+    s32 a;
+    s32 b;
+    s32 c;
+
+    if ((prim->type == NUPT_NDXTRI) || (prim->type == NUPT_NDXTRISTRIP)) {
+        idx = (u16*)prim->idxbuff;
+        n = prim->cnt;
+    } else {
+        idx = NULL;
+        n = geom->vtxcnt;
+    }
+    if ((prim->type == NUPT_NDXTRI) || (prim->type == NUPT_TRI)) {
+        n -= n % 3;
+        for (i = 0; i < n; i++) {
+            *out++ = (u16)(base + ((idx != NULL) ? idx[i] : i));
+        }
+        return out;
+    }
+    for (i = 0; i + 2 < n; i++) {
+        a = (idx != NULL) ? idx[i] : i;
+        b = (idx != NULL) ? idx[i + 1] : i + 1;
+        c = (idx != NULL) ? idx[i + 2] : i + 2;
+        if ((a == b) || (b == c) || (a == c)) {
+            continue;
+        }
+        if ((i & 1) != 0) {
+            *out++ = (u16)(base + b);
+            *out++ = (u16)(base + a);
+        } else {
+            *out++ = (u16)(base + a);
+            *out++ = (u16)(base + b);
+        }
+        *out++ = (u16)(base + c);
+    }
+    return out;
+}
+
 //MATCH GCN
 // Vertex stride = size of 1 vertex element
 int NuVtxStride(enum nuvtxtype_e type)
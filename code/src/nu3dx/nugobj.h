@@ -28,6 +28,9 @@ void GS_DeleteBuffer(void* ptr);
 int NuVtxStride(enum nuvtxtype_e type);
 void NuAnimUV(void);*/
 void NuGobjCalcDims(struct nugobj_s* gobj);
+// Unroll a prim into a u16 triangle list, for merging several geoms into one.
+s32 NuPrimTriListSize(struct nugeom_s* geom, struct nuprim_s* prim);
+u16* NuPrimTriList(u16* out, struct nugeom_s* geom, struct nuprim_s* prim, s32 base);
 /**********************************************************/
 // Variables
 /**********************************************************/
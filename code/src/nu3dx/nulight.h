@@ -5,6 +5,7 @@
 #include "nu3dx/nu3dxtypes.h"
 #include "system/gs/gs.h"
 #include "nu3dx/numtl.h"
+#include "nuxbox/nuscratch.h"
 
 /*
   800b14dc 0000cc 800b14dc  4 NuLightInit 	Global
@@ -1,5 +1,6 @@
 #include "nurndr.h"
 #include "../system.h"
+#include "numath/nusimd.h"
 
 #define PI 3.1415927f
 #define MAX_FIXED_POINT 65536
@@ -27,10 +28,10 @@ void NuRndrInit(void) {
       return;
 }
 
-//MATCH GCN
 s32 NuRndrBeginScene(s32 hRT) {
   u32 bs;
 
+  NuRndrSceneCount++;
   if (rndrmtx_cnt_max > rndrmtx_cnt) {
     rndrmtx_cnt_max = rndrmtx_cnt;
   }
@@ -326,6 +327,54 @@ s32 NuRndrGrassGobj(struct nugobj_s *gobj,struct numtx_s *wm,float **blendvals)
     return total_outcode;
 }
 
+// Queue every geom of a gobj the caller has already culled, under one matrix. outcode 1 means it's wholly on screen.
+void NuRndrGrassBatch(struct nugobj_s* gobj, struct numtx_s* wm, s32 outcode) {
+    struct nugeomitem_s* item;
+    struct nugeom_s* geom;
+    struct numtx_s* mtx;
+    s32 current_lights;
+
+    mtx = NULL;
+    current_lights = 0;
+    for (geom = gobj->geom; geom != NULL; geom = geom->next) {
+        if ((geom->vtxcnt == 0) || (geom->prim->cnt == 0)) {
+            continue;
+        }
+        if (geomitem_cnt == 0) {
+            NuErrorProlog("C:/source/crashwoc/code/nu3dx/nurndr.c", __LINE__)("NuRndrGrassBatch : No free geom item slots!");
+            return;
+        }
+        // the matrix slot is only taken once there's a geom to queue under it
+        if (mtx == NULL) {
+            rndrmtx_cnt--;
+            if (rndrmtx_cnt < 0) {
+                NuErrorProlog("C:/source/crashwoc/code/nu3dx/nurndr.c", __LINE__)("NuRndrGrassBatch : No free matrix slots!");
+            }
+            mtx = &rndrmtx[rndrmtx_cnt];
+            *mtx = *wm;
+            current_lights = NuLightStoreCurrentLights();
+        }
+        geomitem_cnt--;
+        item = &geomitem[geomitem_cnt];
+        item->hdr.type = NURNDRITEM_GEOM3D;
+        item->hdr.flags = (outcode == 1) ? 1 : 0;
+        item->hdr.lights_index = current_lights;
+        item->mtx = mtx;
+        item->geom = geom;
+        item->blendvals = NULL;
+        item->hShader = NuShaderAssignShader(geom);
+        if ((nurndr_forced_mtl_table != NULL) && (geom->mtl->special_id != 0)) {
+            if (nurndr_forced_mtl_table[geom->mtl->special_id] != NULL) {
+                NuMtlAddRndrItem(nurndr_forced_mtl_table[geom->mtl->special_id], &item->hdr);
+            }
+        } else if (nurndr_forced_mtl != NULL) {
+            NuMtlAddRndrItem(nurndr_forced_mtl, &item->hdr);
+        } else {
+            NuMtlAddRndrItem(geom->mtl, &item->hdr);
+        }
+    }
+}
+
 
 //MATCH NGC
 s32 NuRndrGobjSkin2(struct nugobj_s *gobj, int nummtx, struct numtx_s *wm, float **blendvals)
@@ -682,46 +731,66 @@ static void NuRndrGeomItem(struct nugeomitem_s *item) {
   return;
 }
 
-//NGC MATCH
-static void NuRndrBlendedSkinItem(struct nugeomitem_s* item) {
-  float blendval;
-  int j;
-  struct nuvec_s** LCBlendOffsets;
-  struct nugeom_s *geom;
-  struct nuvtx_sk3tc1_s *srcverts;
-  struct nuvec_s *destvb;
-  int i;
+// Rebuilds the blended positions in the blend VB, skipping it when the weights match the last build.
+static void NuRndrBlendShapes(struct nugeomitem_s* item)
+{
   struct NUBLENDGEOM_s *blendgeom;
-  struct nuprim_s *prim;
+  struct NUBLENDTARGET_s *target;
+  struct nuvec_s *destvb;
+  float blendval;
+  float *acc;
+  float *d;
+  nuf4 wv;
+  s32 changed;
+  s32 i;
+  s32 j;
 
   blendgeom = item->geom->blendgeom;
+  changed = !blendgeom->cached;
+  for (j = 0; j < blendgeom->nblends; j++) {
+      blendval = (blendgeom->blend_offsets[j] != NULL) ? (*item->blendvals)[blendgeom->ix[j]] : 0.0f;
+      if (blendval != blendgeom->lastvals[j]) {
+          blendgeom->lastvals[j] = blendval;
+          changed = 1;
+      }
+  }
+  if (!changed) {
+      return;
+  }
+
+  memcpy(blendgeom->acc, blendgeom->base, blendgeom->nblocks * 12 * sizeof(float));
+  for (j = 0; j < blendgeom->nblends; j++) {
+      blendval = blendgeom->lastvals[j];
+      if (blendval == 0.0f) {
+          continue;
+      }
+      target = &blendgeom->targets[j];
+      wv = NuF4Set1(blendval);
+      for (i = 0; i < target->nblocks; i++) {
+          acc = &blendgeom->acc[target->block[i] * 12];
+          d = &target->delta[i * 12];
+          NuF4StoreU(acc, NuF4Madd(NuF4LoadU(d), wv, NuF4LoadU(acc)));
+          NuF4StoreU(acc + 4, NuF4Madd(NuF4LoadU(d + 4), wv, NuF4LoadU(acc + 4)));
+          NuF4StoreU(acc + 8, NuF4Madd(NuF4LoadU(d + 8), wv, NuF4LoadU(acc + 8)));
+      }
+  }
+
+  destvb = (struct nuvec_s *)blendgeom->hVB;
+  for (i = 0; i < item->geom->vtxcnt; i++) {
+      acc = &blendgeom->acc[(i >> 2) * 12 + (i & 3)];
+      destvb[i].x = acc[0];
+      destvb[i].y = acc[4];
+      destvb[i].z = acc[8];
+  }
+  blendgeom->cached = 1;
+}
+
+static void NuRndrBlendedSkinItem(struct nugeomitem_s* item) {
+  struct nuprim_s *prim;
+
   DBTimerStart(4);
   DBTimerStart(0xd);
-  //PPCMtmmcr0(0x8b);
-  //PPCMtmmcr1(0x78400000);
-  geom = item->geom;
-  srcverts = (struct nuvtx_sk3tc1_s *)geom->hVB;
-  destvb = (struct nuvec_s *)geom->blendgeom->hVB;
-    for (i = 0; i < item->geom->vtxcnt; i++) {
-        destvb->x = srcverts->pnt.x;
-        destvb->y = srcverts->pnt.y;
-        destvb->z = srcverts->pnt.z;
-        for (j = 0; j < blendgeom->nblends; j++) {
-          LCBlendOffsets = blendgeom->blend_offsets[j];
-            if (LCBlendOffsets != 0) {
-            blendval = (*item->blendvals)[*(j + blendgeom->ix)];
-            if (blendval != 0.0f) {
-                destvb->x =  ((*(f32*)&LCBlendOffsets[i * 3] * blendval) + destvb->x);
-                destvb->y =  (((i + (blendgeom->blend_offsets[j]))->y * blendval) + destvb->y); //(*LCBlendOffsets[i])
-                destvb->z =  (((i + (blendgeom->blend_offsets[j]))->z * blendval) + destvb->z);
-                }
-            }
-        }
-      destvb = destvb + 1;
-      srcverts = srcverts + 1;
-    }
-  //PPCMtmmcr1(0);
-  //PPCMtmmcr0(0);
+  NuRndrBlendShapes(item);
   DBTimerEnd(0xd);
   SetupShaders(item);
   GS_LoadWorldMatrixIdentity();
@@ -152,8 +152,14 @@ struct numtl_s* nurndr_forced_mtl;
 
 struct numtl_s** nurndr_forced_mtl_table;
 
+// Bumped by NuRndrBeginScene, items queued under an older count have been drawn.
+s32 NuRndrSceneCount;
+
 s32 NuRndrShadowCnt;
 
+// Queue a pre-culled gobj, used for the batched grass clumps.
+void NuRndrGrassBatch(struct nugobj_s* gobj, struct numtx_s* wm, s32 outcode);
+
 struct WaterDat NuRndrWaterRipDat[32];
 
 static s32 rndrmtx_cnt;
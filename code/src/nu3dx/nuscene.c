@@ -377,6 +377,89 @@ static void ReadNuIFFGeomSkin(s32 handle,struct nugeom_s *geom) {
   return;
 }
 
+static s32 NuBlendBlockMoves(struct nuvec_s* off, s32 block, s32 vtxcnt)
+{
+    s32 v;
+
+    for (v = block * 4; (v < block * 4 + 4) && (v < vtxcnt); v++) {
+        if ((off[v].x != 0.0f) || (off[v].y != 0.0f) || (off[v].z != 0.0f)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Splits the blend offsets into blocks of 4 vertices for NuRndrBlendedSkinItem, each blend keeping only the blocks it moves.
+static void NuBlendGeomBuildTargets(struct nugeom_s* geom)
+{
+    struct NUBLENDGEOM_s* blendgeom;
+    struct NUBLENDTARGET_s* target;
+    struct nuvtx_sk3tc1_s* srcverts;
+    struct nuvec_s* off;
+    float* d;
+    s32 nbytes;
+    s32 i;
+    s32 j;
+    s32 b;
+    s32 k;
+    s32 v;
+
+    blendgeom = geom->blendgeom;
+    srcverts = (struct nuvtx_sk3tc1_s*)geom->hVB;
+    blendgeom->nblocks = (geom->vtxcnt + 3) >> 2;
+    blendgeom->cached = 0;
+
+    nbytes = blendgeom->nblocks * 12 * sizeof(float);
+    blendgeom->base = (float*)NuMemAlloc(nbytes);
+    blendgeom->acc = (float*)NuMemAlloc(nbytes);
+    memset(blendgeom->base, 0, nbytes);
+    for (i = 0; i < geom->vtxcnt; i++) {
+        d = &blendgeom->base[(i >> 2) * 12 + (i & 3)];
+        d[0] = srcverts[i].pnt.x;
+        d[4] = srcverts[i].pnt.y;
+        d[8] = srcverts[i].pnt.z;
+    }
+
+    blendgeom->lastvals = (float*)NuMemAlloc(blendgeom->nblends * sizeof(float));
+    blendgeom->targets = (struct NUBLENDTARGET_s*)NuMemAlloc(blendgeom->nblends * sizeof(struct NUBLENDTARGET_s));
+    memset(blendgeom->targets, 0, blendgeom->nblends * sizeof(struct NUBLENDTARGET_s));
+
+    for (j = 0; j < blendgeom->nblends; j++) {
+        off = blendgeom->blend_offsets[j];
+        if (off == NULL) {
+            continue;
+        }
+        target = &blendgeom->targets[j];
+
+        for (b = 0; b < blendgeom->nblocks; b++) {
+            if (NuBlendBlockMoves(off, b, geom->vtxcnt)) {
+                target->nblocks++;
+            }
+        }
+        if (target->nblocks == 0) {
+            continue;
+        }
+        target->block = (s32*)NuMemAlloc(target->nblocks * sizeof(s32));
+        target->delta = (float*)NuMemAlloc(target->nblocks * 12 * sizeof(float));
+        memset(target->delta, 0, target->nblocks * 12 * sizeof(float));
+
+        k = 0;
+        for (b = 0; b < blendgeom->nblocks; b++) {
+            if (!NuBlendBlockMoves(off, b, geom->vtxcnt)) {
+                continue;
+            }
+            target->block[k] = b;
+            d = &target->delta[k * 12];
+            for (v = b * 4; (v < b * 4 + 4) && (v < geom->vtxcnt); v++) {
+                d[v & 3] = off[v].x;
+                d[(v & 3) + 4] = off[v].y;
+                d[(v & 3) + 8] = off[v].z;
+            }
+            k++;
+        }
+    }
+}
+
 //84%
 static void ReadNuIFFBlendShape(s32 fh,struct nugeom_s *geom) {
     s32 i;
@@ -441,6 +524,7 @@ static void ReadNuIFFBlendShape(s32 fh,struct nugeom_s *geom) {
             }
         }
         geom->blendgeom->hVB =  GS_CreateBuffer(geom->vtxcnt * 0xc,3);
+        NuBlendGeomBuildTargets(geom);
     }
 }
 
@@ -477,6 +561,7 @@ s32 ReadNuIFFInstSet(s32 fh,struct nuinstance_s **instances,struct nuinstanim_s
           if (instance->anim != 0) {
               instance->anim = linstanims++;
               instance->anim->mtx = instance->mtx;
+              instance->anim->evalvalid = 0;
           }
       }
   }
@@ -647,7 +732,6 @@ void ReadNuIFFGScene(s32 handle,struct nugscn_s *gscene) {
     return;
 }
 
-//NGC MATCH
 struct nuscene_s * NuSceneLoad(char *filename) {
   s32 fh;
   struct nuscene_s *scene;
@@ -672,9 +756,10 @@ struct nuscene_s * NuSceneLoad(char *filename) {
             memset(scene,0,0x3c);
             blk = blkcnt;
             if (NuFileBeginBlkRead(fh,0) == 0x30435347) { //"0CSG"
-              scene->gscene = (struct nugscn_s *)NuMemAlloc(0x74);
-              memset(scene->gscene,0,0x74);
+              scene->gscene = (struct nugscn_s *)NuMemAlloc(sizeof(struct nugscn_s));
+              memset(scene->gscene,0,sizeof(struct nugscn_s));
               ReadNuIFFGScene(fh,scene->gscene);
+              NuGScnBuildNameIndex(scene->gscene);
                 for (i = 0; i < scene->gscene->numinstance; i++) {
                       for (geom1 = scene->gscene->gobjs[scene->gscene->instances[i].objid]->geom;
                           geom1 != NULL; geom1 = geom1->next) {
@@ -716,10 +801,44 @@ s8* ReadNuIFFNameTable(s32 handle) {
     return str;
 }
 
-//NGC MATCH
+// Name lookups for NuSplineFind, NuSpecialFind and friends, built once the scene is read.
+void NuGScnBuildNameIndex(struct nugscn_s* gsc) {
+  s32 i;
+
+  NuGScnDestroyNameIndex(gsc);
+  if (gsc->numsplines + gsc->numspecial == 0) {
+    return;
+  }
+  gsc->ixnames = (char**)NuMemAlloc((gsc->numsplines + gsc->numspecial) * sizeof(char*));
+  if (gsc->ixnames == NULL) {
+    return;
+  }
+  for (i = 0; i < gsc->numsplines; i++) {
+    gsc->ixnames[i] = gsc->splines[i].name;
+  }
+  for (i = 0; i < gsc->numspecial; i++) {
+    gsc->ixnames[gsc->numsplines + i] = gsc->specials[i].name;
+  }
+  gsc->splineix = NuNameIxCreate(gsc->ixnames,gsc->numsplines);
+  gsc->specialix = NuNameIxCreate(gsc->ixnames + gsc->numsplines,gsc->numspecial);
+}
+
+void NuGScnDestroyNameIndex(struct nugscn_s* gsc) {
+  NuNameIxDestroy(gsc->splineix);
+  NuNameIxDestroy(gsc->specialix);
+  if (gsc->ixnames != NULL) {
+    NuMemFree(gsc->ixnames);
+  }
+  gsc->splineix = NULL;
+  gsc->specialix = NULL;
+  gsc->ixnames = NULL;
+}
+
 void NuGSceneDestroy(struct nugscn_s *gsc) {
   s32 i;
 
+  NuGScnDestroyNameIndex(gsc);
+
   for (i = 0; i < gsc->numtid; i++) {
     NuTexDestroy((s32)gsc->tids[i]);
   }
@@ -31,5 +31,7 @@ static void NuSceneCalcCulling(struct nugscn_s *scene);
 void ReadNuIFFGScene(fileHandle handle,struct nugscn_s *gscene);
 struct nuscene_s * NuSceneLoad(char *filename);
 s8* ReadNuIFFNameTable(s32 handle);
+void NuGScnBuildNameIndex(struct nugscn_s* gsc);
+void NuGScnDestroyNameIndex(struct nugscn_s* gsc);
 
 #endif // !NUSCENE_H
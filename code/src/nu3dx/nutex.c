@@ -352,6 +352,13 @@ void NuTexSetTexture(u32 stage,s32 tid) {
   return;
 }
 
+void NuTexUpdate(s32 tid,void *bits) {
+  if (tid > 0) {
+    GS_TexUpdateNU(tid - 1,(u8 *)bits);
+  }
+  return;
+}
+
 //MATCH GCN
 struct nutex_s * NuTexReadBitmap(char* fileName)
 {
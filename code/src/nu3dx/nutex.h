@@ -81,6 +81,9 @@ s32 NuTexImgSize(enum nutextype_e type, s32 width, s32 height);
 // Get the texture palette size.
 s32 NuTexPalSize(enum nutextype_e type);
 
+// Replace the texels of a texture created from RGBA32 data, bits must be the same size.
+void NuTexUpdate(s32 tid, void* bits);
+
 // Read bitmap data into a texture.
 s32 NuTexReadBitmapMM(char* fileName, s32 mmlevel, struct nutex_s* tex); // TODO!!! FINISH!!!
 
@@ -2,6 +2,25 @@
 #include "../system.h"
 
 struct numtl_s* DebMat[8]; //debris.c
+s32 dynamicWaterEnabled = 1;
+
+// The water is simulated on the CPU, heights are double buffered and each row is padded so the
+// neighbour loads at either end read wrapped columns.
+#define NUWATER_GRID 0x80
+#define NUWATER_PAD 4
+#define NUWATER_STRIDE (NUWATER_GRID + NUWATER_PAD * 2)
+#define NUWATER_BAND 16         // rows a job
+#define NUWATER_WAVE 0.25f      // wave speed, unstable past 0.5
+#define NUWATER_DAMP 0.985f
+#define NUWATER_SETTLE 0.998f   // pulls the surface back to flat
+#define NUWATER_DROP 0.5f
+#define NUWATER_SLOPE 4.0f      // height difference to normal map slope
+
+static float dynamicWaterHeight[2][NUWATER_GRID * NUWATER_STRIDE];
+static float dynamicWaterVelocity[NUWATER_GRID * NUWATER_GRID];
+static u32 dynamicWaterNormalBits[NUWATER_GRID * NUWATER_GRID];
+static float* dynamicWaterHeightSrc;
+static float* dynamicWaterHeightDst;
 
 //NGC MATCH
 static s32 Powr2(s32 v) {
@@ -46,7 +65,6 @@ s32 dynamicWaterGetNormalMap(void) {
 }
 
 
-//NGC MATCH
 static void NuDynamicWaterClose(void) {
     s32 i;
 
@@ -54,6 +72,11 @@ static void NuDynamicWaterClose(void) {
         dynamicWaterInitialised = 0;
         for (i = 0; i < 6; i++) {
             NuTexDestroy(dynamicWaterTextureIds[i]);
+            // NuTexDestroy leaves the GS copy, the normal map is made again every level
+            if (dynamicWaterTextureIds[i] > 0) {
+                GS_TexRelease(dynamicWaterTextureIds[i] - 1);
+            }
+            dynamicWaterTextureIds[i] = 0;
         }
     }
     return;
@@ -121,7 +144,6 @@ static void NuDynamicWaterCalcShaderUVOffsets(s32 width, s32 height, float multi
     return;
 }
 
-//96%
 static void NuDynamicWaterInit() {
     s32 i;
     struct nutex_s tex;
@@ -130,15 +152,13 @@ static void NuDynamicWaterInit() {
         if (dynamicWaterInitialised != 0) {
             NuDynamicWaterClose();
         }
-        tex.type = NUTEX_RT32;
-        tex.width = 0x80;
-        tex.height = 0x80;
-        tex.mmcnt = 0;
+        memset(dynamicWaterHeight,0,sizeof(dynamicWaterHeight));
+        memset(dynamicWaterVelocity,0,sizeof(dynamicWaterVelocity));
+        for (i = 0; i < NUWATER_GRID * NUWATER_GRID; i++) {
+            dynamicWaterNormalBits[i] = 0xffff8080;
+        }
         for (i = 0; i < 6; i++) {
-            tex.type = NUTEX_RT32;
-            tex.width = 0x80;
-            tex.height = 0x80;
-            dynamicWaterTextureIds[i] = NuTexCreate(&tex);
+            dynamicWaterTextureIds[i] = 0;
         }
         dynamicWaterHeightTargetTex = 4;
         dynamicWaterForceTex = 5;
@@ -149,18 +169,16 @@ static void NuDynamicWaterInit() {
         dynamicWaterVelocityTargetTex = 2;
         dynamicWaterBlurTex = 0;
         dynamicWaterFlipState = 0;
-        pDropletTex = NuTexLoadTextureFromDDSFile("stuff\\Droplet1.dds");
-        DropletTex.type = NUTEX_RGBA32;
-        DropletTex.height = 0x20;
-        DropletTex.width = 0x20;
-        DropletTex.linear = 0;
-        DropletTex.pal = 0;
-        DropletTex.mmcnt = 1;
-        DropletTID = NuTexCreateFromSurface(&DropletTex,pDropletTex);
-        NudxFw_SetRenderTargetSurface(dynamicWaterSurfaces[dynamicWaterHeightSourceTex],NULL);
-        NuRndrClear(0xb,-0x7f7f80,1.0f);
-        NudxFw_SetRenderTargetSurface(dynamicWaterSurfaces[dynamicWaterVelocitySourceTex],NULL);
-        NuRndrClear(0xb,-0x7f7f80,1.0f);
+        // only the normal map is a texture now, NuDynamicWaterUpdate refills it every frame
+        tex.type = NUTEX_RGBA32;
+        tex.width = NUWATER_GRID;
+        tex.height = NUWATER_GRID;
+        tex.mmcnt = 1;
+        tex.bits = dynamicWaterNormalBits;
+        tex.pal = NULL;
+        tex.decal = 0;
+        tex.linear = 0;
+        dynamicWaterTextureIds[dynamicWaterNormalTex] = NuTexCreate(&tex);
         dynamicWaterMaterial = NuMtlCreate(1);
         dynamicWaterMaterial->alpha = 0.5f;
         dynamicWaterMaterial->attrib.zmode = 1;
@@ -298,21 +316,49 @@ static void NuDynamicWaterCycleTextures(void) {
     dynamicWaterFlipState = !dynamicWaterFlipState;
 }
 
-//97.40%
+// Push a round dent into the velocity grid, wrapping at the edges like the texture does.
+static void NuDynamicWaterDrop(float cx, float cy, float radius, float depth) {
+    s32 x;
+    s32 y;
+    s32 x0;
+    s32 x1;
+    s32 y0;
+    s32 y1;
+    float dx;
+    float dy;
+    float f;
+    float r2;
+
+    if (radius < 1.0f) {
+        radius = 1.0f;
+    }
+    r2 = radius * radius;
+    x0 = (s32)(cx - radius);
+    x1 = (s32)(cx + radius);
+    y0 = (s32)(cy - radius);
+    y1 = (s32)(cy + radius);
+    for (y = y0; y <= y1; y++) {
+        dy = ((float)y + 0.5f) - cy;
+        for (x = x0; x <= x1; x++) {
+            dx = ((float)x + 0.5f) - cx;
+            f = 1.0f - (dx * dx + dy * dy) / r2;
+            if (f > 0.0f) {
+                dynamicWaterVelocity[(y & (NUWATER_GRID - 1)) * NUWATER_GRID + (x & (NUWATER_GRID - 1))] -= depth * f * f;
+            }
+        }
+    }
+}
+
 static void NuDynamicWaterExcite() {
-    char pad[54];
-    float random;
     float x;
     float y;
     float scale;
     float copy;
-    float temp;
+    float depth;
     float i;
-    int col;
 
     copy = randyfloat();
     if ((dynamicWaterDropFrequency > copy) || (dynamicWaterTurbulenceFrequency != 0)) {
-        NudxFw_SetRenderTargetSurface(dynamicWaterSurfaces[dynamicWaterVelocityTargetTex], NULL);
         if (dynamicWaterDropFrequency > copy) {
             x = randyfloat() * 128.0f;
             y = randyfloat() * 128.0f;
@@ -321,107 +367,117 @@ static void NuDynamicWaterExcite() {
             } else {
                 scale = randyfloat() * dynamicWaterDropMaxScale;
             }
-            temp = DebMat[0]->tid;
-            DebMat[0]->tid = DropletTID;
-            NuRndrRectUV2di((int)x, (int)y, scale * 32.0f, scale * 32.0f, 0.0f, 0.0f, 1.0f, 1.0f, -1, DebMat[0]);
-            DebMat[0]->tid = temp;
+            // the droplet sprite was drawn scale * 32 texels across from x, y
+            NuDynamicWaterDrop(x + scale * 16.0f, y + scale * 16.0f, scale * 16.0f, NUWATER_DROP);
         }
         if (dynamicWaterTurbulenceFrequency != 0) {
-            col = (dynamicWaterTurbulenceStrength << 0x18) + (dynamicWaterTurbulenceStrength << 0x10)
-                + (dynamicWaterTurbulenceStrength << 0x8) + dynamicWaterTurbulenceStrength;
-            scale = dynamicWaterTurbulenceScale * 32.0f;
+            depth = (float)dynamicWaterTurbulenceStrength * (NUWATER_DROP / 255.0f);
+            scale = dynamicWaterTurbulenceScale * 16.0f;
             for (i = 0.0f; i < (float)dynamicWaterTurbulenceFrequency; i += (1.0f / 128.0f)) {
                 x = randyfloat() * 128.0f;
                 y = randyfloat() * 128.0f;
-                temp = DebMat[0]->tid;
-                DebMat[0]->tid = DropletTID;
-                NuRndrRectUV2di((int)x, (int)y, (int)scale, (int)scale, 0.0f, 0.0f, 1.0f, 1.0f, col, DebMat[0]);
-                DebMat[0]->tid = temp;
+                NuDynamicWaterDrop(x + scale, y + scale, scale, depth);
             }
         }
     }
     return;
 }
 
-//NGC MATCH
-void NuDynamicWaterUpdate(s32 forceupdate) {
-    struct D3DSurface *currentBackBuffer;
-    struct D3DSurface *currentZBuffer;
+// One wave equation step for a band of rows, source heights to destination heights.
+static void NuDynamicWaterStepRows(void* data, s32 start, s32 end) {
+    float* c;
+    float* u;
+    float* d;
+    float* h;
+    float* v;
+    nuf4 hc;
+    nuf4 sum;
+    nuf4 vel;
+    nuf4 k;
+    nuf4 damp;
+    nuf4 settle;
+    nuf4 four;
+    s32 x;
+    s32 y;
+
+    k = NuF4Set1(NUWATER_WAVE);
+    damp = NuF4Set1(NUWATER_DAMP);
+    settle = NuF4Set1(NUWATER_SETTLE);
+    four = NuF4Set1(4.0f);
+    for (y = start; y < end; y++) {
+        c = dynamicWaterHeightSrc + y * NUWATER_STRIDE + NUWATER_PAD;
+        u = dynamicWaterHeightSrc + ((y - 1) & (NUWATER_GRID - 1)) * NUWATER_STRIDE + NUWATER_PAD;
+        d = dynamicWaterHeightSrc + ((y + 1) & (NUWATER_GRID - 1)) * NUWATER_STRIDE + NUWATER_PAD;
+        h = dynamicWaterHeightDst + y * NUWATER_STRIDE + NUWATER_PAD;
+        v = dynamicWaterVelocity + y * NUWATER_GRID;
+        for (x = 0; x < NUWATER_GRID; x += 4) {
+            hc = NuF4LoadU(c + x);
+            sum = NuF4Add(NuF4Add(NuF4LoadU(c + x - 1), NuF4LoadU(c + x + 1)), NuF4Add(NuF4LoadU(u + x), NuF4LoadU(d + x)));
+            vel = NuF4Mul(NuF4Madd(NuF4Sub(sum, NuF4Mul(hc, four)), k, NuF4LoadU(v + x)), damp);
+            NuF4StoreU(v + x, vel);
+            NuF4StoreU(h + x, NuF4Mul(NuF4Add(hc, vel), settle));
+        }
+        h[-1] = h[NUWATER_GRID - 1];
+        h[NUWATER_GRID] = h[0];
+    }
+}
+
+// Normal map texels for a band of rows from the destination heights, x and y slope in red and green.
+static void NuDynamicWaterNormalRows(void* data, s32 start, s32 end) {
+    float* c;
+    float* u;
+    float* d;
+    u32* out;
+    float r[4];
+    float g[4];
+    float b[4];
+    nuf4 gx;
+    nuf4 gy;
+    nuf4 slope;
+    nuf4 lo;
+    nuf4 hi;
+    nuf4 half;
+    nuf4 scale;
+    nuf4 bias;
+    s32 x;
+    s32 y;
     s32 i;
 
-    if (((dynamicWaterInitialised != 0) && (dynamicWaterEnabled != 0)) && ((watervisible != 0 || (forceupdate != 0)))) {
-        currentBackBuffer = NudxFw_GetBackBuffer();
-        currentZBuffer = NudxFw_GetZBuffer();
-        ResetShaders();
-        GS_SetZCompare(0,0,GX_LEQUAL);
-        NudxFw_SetRenderState(0x52,0);
-        GS_SetAlphaCompare(7,0);
-        GS_SetBlendSrc(0,0,1);
-        NudxFw_SetRenderState(0x5d,0);
-        NudxFw_SetRenderState(0x7d,0);
-        GS_EnableLighting(0);
-        GS_EnableColorVertex(0);
-        //NuSetShaderState(CALCNEIGHBOURFORCE,NUVT_TLTC1);
-        NudxFw_SetRenderTargetSurface(dynamicWaterSurfaces[dynamicWaterForceStepOneTex],NULL);
-        GS_SetBlendSrc(1,1,0);
-        NuTexSetTexture(0,dynamicWaterTextureIds[dynamicWaterHeightSourceTex]);
-        NuTexSetTexture(1,dynamicWaterTextureIds[dynamicWaterHeightSourceTex]);
-        NuTexSetTexture(2,dynamicWaterTextureIds[dynamicWaterHeightSourceTex]);
-        NuTexSetTexture(3,dynamicWaterTextureIds[dynamicWaterHeightSourceTex]);
-        for (i = 0; i < 4; i++) {
-            NudxFw_SetTextureState(i,D3DTSS_MAGFILTER,2);
-            NudxFw_SetTextureState(i,D3DTSS_MINFILTER,2);
-            NudxFw_SetTextureState(i,D3DTSS_MIPFILTER,0);
-            NudxFw_SetTextureState(i,D3DTSS_TEXTURETRANSFORMFLAGS,0);
-            NudxFw_SetTextureState(i,D3DTSS_TEXCOORDINDEX,i);
-            NudxFw_SetTextureState(i,D3DTSS_RESULTARG,1);
+    slope = NuF4Set1(-0.5f * NUWATER_SLOPE);
+    lo = NuF4Set1(-0.7f);
+    hi = NuF4Set1(0.7f);
+    half = NuF4Set1(-0.5f);
+    scale = NuF4Set1(127.0f);
+    bias = NuF4Set1(128.0f);
+    for (y = start; y < end; y++) {
+        c = dynamicWaterHeightDst + y * NUWATER_STRIDE + NUWATER_PAD;
+        u = dynamicWaterHeightDst + ((y - 1) & (NUWATER_GRID - 1)) * NUWATER_STRIDE + NUWATER_PAD;
+        d = dynamicWaterHeightDst + ((y + 1) & (NUWATER_GRID - 1)) * NUWATER_STRIDE + NUWATER_PAD;
+        out = dynamicWaterNormalBits + y * NUWATER_GRID;
+        for (x = 0; x < NUWATER_GRID; x += 4) {
+            gx = NuF4Min(NuF4Max(NuF4Mul(NuF4Sub(NuF4LoadU(c + x + 1), NuF4LoadU(c + x - 1)), slope), lo), hi);
+            gy = NuF4Min(NuF4Max(NuF4Mul(NuF4Sub(NuF4LoadU(d + x), NuF4LoadU(u + x)), slope), lo), hi);
+            // 1 - (x^2 + y^2) / 2 is close enough to the unit length z for slopes this small
+            NuF4StoreU(b, NuF4Madd(NuF4Madd(NuF4Madd(gx, gx, NuF4Mul(gy, gy)), half, NuF4Set1(1.0f)), scale, bias));
+            NuF4StoreU(r, NuF4Madd(gx, scale, bias));
+            NuF4StoreU(g, NuF4Madd(gy, scale, bias));
+            for (i = 0; i < 4; i++) {
+                out[x + i] = 0xff000000 | ((u32)b[i] << 16) | ((u32)g[i] << 8) | (u32)r[i];
+            }
         }
-        NuDynamicWaterSetVertexShaderUVOffsets(1);
-        NuDynamicWaterRender2dRect(0x80,0x80);
-        //NuSetShaderState(CALCNEIGHBOURFORCE2,NUVT_TLTC1);
-        NudxFw_SetRenderTargetSurface(dynamicWaterSurfaces[dynamicWaterForceTex],NULL);
-        NuTexSetTexture(0,dynamicWaterTextureIds[dynamicWaterHeightSourceTex]);
-        NuTexSetTexture(1,dynamicWaterTextureIds[dynamicWaterHeightSourceTex]);
-        NuTexSetTexture(2,dynamicWaterTextureIds[dynamicWaterForceStepOneTex]);
-        NuDynamicWaterSetVertexShaderUVOffsets(2);
-        NuDynamicWaterRender2dRect(0x80,0x80);
-        //NuSetShaderState(APPLYFORCEORVELOCITY,NUVT_TLTC1);
-        NudxFw_SetRenderTargetSurface(dynamicWaterSurfaces[dynamicWaterVelocityTargetTex],NULL);
-        NuTexSetTexture(0,dynamicWaterTextureIds[dynamicWaterVelocitySourceTex]);
-        NuTexSetTexture(1,dynamicWaterTextureIds[dynamicWaterForceTex]);
-        NuTexSetTexture(2,0);
-        NuTexSetTexture(3,0);
-        NuDynamicWaterSetVertexShaderUVOffsets(0);
-        NuDynamicWaterRender2dRect(0x80,0x80);
-        //NuSetShaderState(APPLYFORCEORVELOCITY,NUVT_TLTC1);
-        NudxFw_SetRenderTargetSurface(dynamicWaterSurfaces[dynamicWaterHeightTargetTex],NULL);
-        NuTexSetTexture(0,dynamicWaterTextureIds[dynamicWaterHeightSourceTex]);
-        NuTexSetTexture(1,dynamicWaterTextureIds[dynamicWaterVelocityTargetTex]);
-        NuDynamicWaterRender2dRect(0x80,0x80);
-        //NuSetShaderState(BLURFILTER,NUVT_TLTC1);
-        NudxFw_SetRenderTargetSurface(dynamicWaterSurfaces[dynamicWaterBlurTex],NULL);
-        i = dynamicWaterHeightTargetTex;
-        dynamicWaterHeightTargetTex = dynamicWaterHeightSourceTex;
-        dynamicWaterHeightSourceTex = i;
-        NuTexSetTexture(0,dynamicWaterTextureIds[dynamicWaterHeightSourceTex]);
-        NuTexSetTexture(1,dynamicWaterTextureIds[dynamicWaterHeightSourceTex]);
-        NuTexSetTexture(2,dynamicWaterTextureIds[dynamicWaterHeightSourceTex]);
-        NuTexSetTexture(3,dynamicWaterTextureIds[dynamicWaterHeightSourceTex]);
-        NuDynamicWaterSetVertexShaderUVOffsets(4);
-        NuDynamicWaterRender2dRect(0x80,0x80);
-        //NuSetShaderState(CREATENORMALMAP,NUVT_TLTC1);
-        NudxFw_SetRenderTargetSurface(dynamicWaterSurfaces[dynamicWaterNormalTex],NULL);
-        NuTexSetTexture(0,dynamicWaterTextureIds[dynamicWaterHeightTargetTex]);
-        NuTexSetTexture(1,dynamicWaterTextureIds[dynamicWaterHeightTargetTex]);
-        NuTexSetTexture(2,dynamicWaterTextureIds[dynamicWaterHeightTargetTex]);
-        NuTexSetTexture(3,dynamicWaterTextureIds[dynamicWaterHeightTargetTex]);
-        NuDynamicWaterSetVertexShaderUVOffsets(5);
-        NuDynamicWaterRender2dRect(0x80,0x80);
+    }
+}
+
+void NuDynamicWaterUpdate(s32 forceupdate) {
+    if (((dynamicWaterInitialised != 0) && (dynamicWaterEnabled != 0)) && ((watervisible != 0 || (forceupdate != 0)))) {
+        dynamicWaterHeightSrc = dynamicWaterHeight[dynamicWaterFlipState];
+        dynamicWaterHeightDst = dynamicWaterHeight[!dynamicWaterFlipState];
+        // the normal pass reads the rows either side of its band, so every band has to be stepped first
+        NuJobParallelFor(NuDynamicWaterStepRows,NULL,NUWATER_GRID,NUWATER_BAND);
+        NuJobParallelFor(NuDynamicWaterNormalRows,NULL,NUWATER_GRID,NUWATER_BAND);
+        NuTexUpdate(dynamicWaterTextureIds[dynamicWaterNormalTex],dynamicWaterNormalBits);
         NuDynamicWaterExcite();
         NuDynamicWaterCycleTextures();
-        NudxFw_SetRenderTargetSurface(currentBackBuffer,currentZBuffer);
-        ResetShaders();
-        NudxFw_SetRenderState(0x52,fog_enabled);
     }
     return;
 }
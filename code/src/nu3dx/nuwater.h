@@ -36,7 +36,7 @@ static s32 nwater_mtl;
 static struct nugscn_s* wgsc[256];
 static struct nuinstance_s* winst[256];
 static s32 dynamicWaterInitialised;
-static s32 dynamicWaterEnabled;
+extern s32 dynamicWaterEnabled;
 static s32 dynamicWaterForceStepOneTex;
 static s32 dynamicWaterTextureIds[6];
 static struct nuvec4_s dynamicWaterUVOffsets[2][6];
@@ -58,8 +58,8 @@ static float dynamicWaterDropFrequency;
 static float dynamicWaterBlurDist;
 float dynamicWaterBlend;
 float dynamicWaterScale;
-static f32 dynamicWaterDropMaxScale;
-static f32 dynamicWaterDropMinScale;
+static f32 dynamicWaterDropMaxScale = 0.25f;
+static f32 dynamicWaterDropMinScale = 0.1f;
 static s32 dynamicWaterTurbulenceFrequency;
 static f32 dynamicWaterTurbulenceScale;
 static s32 dynamicWaterTurbulenceStrength;
@@ -1,9 +1,12 @@
 #ifndef NUCORE_H
 #define NUCORE_H
 
+#include "nucore/nuatomic.h"
 #include "nucore/nuerror.h"
 #include "nucore/nufile.h"
 #include "nucore/nufpar.h"
+#include "nucore/nujob.h"
 #include "nucore/numem.h"
+#include "nucore/nunameix.h"
 
 #endif // !NUCORE_H
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef NUATOMIC_H
+#define NUATOMIC_H
+
+#include "../types.h"
+
+/*
+  32 bit atomics for the PC threading paths. All are full barriers.
+  NuAtomicCas32 returns the value seen before the swap, NuAtomicAdd32 the value after the add.
+*/
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+static inline s32 NuAtomicCas32(volatile s32* p, s32 expected, s32 desired) { return _InterlockedCompareExchange((volatile long*)p, desired, expected); }
+static inline s32 NuAtomicAdd32(volatile s32* p, s32 v) { return _InterlockedExchangeAdd((volatile long*)p, v) + v; }
+static inline s32 NuAtomicSwap32(volatile s32* p, s32 v) { return _InterlockedExchange((volatile long*)p, v); }
+static inline s32 NuAtomicLoad32(volatile s32* p) { return _InterlockedOr((volatile long*)p, 0); }
+
+#else
+
+static inline s32 NuAtomicCas32(volatile s32* p, s32 expected, s32 desired) { return __sync_val_compare_and_swap(p, expected, desired); }
+static inline s32 NuAtomicAdd32(volatile s32* p, s32 v) { return __sync_add_and_fetch(p, v); }
+static inline s32 NuAtomicSwap32(volatile s32* p, s32 v) { __sync_synchronize(); return __sync_lock_test_and_set(p, v); }
+static inline s32 NuAtomicLoad32(volatile s32* p) { return __sync_fetch_and_or(p, 0); }
+
+#endif
+
+#endif // !NUATOMIC_H
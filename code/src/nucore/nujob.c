@@ -0,0 +1,273 @@
+#include "nujob.h"
+#include "nuatomic.h"
+#include "nuerror.h"
+#include "../nuxbox/nuscratch.h"
+#include "../../include/SDL/SDL_thread.h"
+#include "../../include/SDL/SDL_mutex.h"
+#include "../../include/SDL/SDL_timer.h"
+
+#define NUJOB_MAXWORKERS 16
+
+s32 NuJobWorkers = 3;
+
+static SDL_Thread* nujob_thread[NUJOB_MAXWORKERS];
+static SDL_sem* nujob_wake;
+static SDL_sem* nujob_done;
+static s32 nujob_nthreads;
+static volatile s32 nujob_quit;
+
+// The range being worked on, set before the workers are woken.
+static nujobfn_t nujob_fn;
+static void* nujob_data;
+static s32 nujob_count;
+static s32 nujob_chunk;
+static volatile s32 nujob_next;
+static s32 nujob_busy;
+
+// The stage list being run, claimed and finished are bitmasks of stage indices.
+static struct nujobstage_s* nujob_stages;
+static s32 nujob_nstages;
+static volatile s32 nujob_claimed;
+static volatile s32 nujob_finished;
+static u32 nujob_mainid;
+// Lanes with nothing ready sleep on nujob_stagecond until another stage finishes.
+static SDL_mutex* nujob_stagelock;
+static SDL_cond* nujob_stagecond;
+
+static void NuJobRun(void) {
+    s32 start;
+    s32 end;
+
+    for (;;) {
+        start = NuAtomicAdd32(&nujob_next, nujob_chunk) - nujob_chunk;
+        if (start >= nujob_count) {
+            break;
+        }
+        end = start + nujob_chunk;
+        if (end > nujob_count) {
+            end = nujob_count;
+        }
+        nujob_fn(nujob_data, start, end);
+    }
+}
+
+static int NuJobThread(void* unused) {
+    for (;;) {
+        SDL_SemWait(nujob_wake);
+        if (nujob_quit) {
+            break;
+        }
+        NuJobRun();
+        SDL_SemPost(nujob_done);
+    }
+    NuScratchThreadClose();
+    return 0;
+}
+
+static void NuJobStart(void) {
+    s32 i;
+
+    nujob_quit = 0;
+    nujob_wake = SDL_CreateSemaphore(0);
+    nujob_done = SDL_CreateSemaphore(0);
+    if ((nujob_wake == NULL) || (nujob_done == NULL)) {
+        return;
+    }
+    for (i = 0; (i < NuJobWorkers) && (i < NUJOB_MAXWORKERS); i++) {
+        nujob_thread[i] = SDL_CreateThread(NuJobThread, NULL);
+        if (nujob_thread[i] == NULL) {
+            break;
+        }
+    }
+    nujob_nthreads = i;
+}
+
+void NuJobParallelFor(nujobfn_t fn, void* data, s32 count, s32 chunk) {
+    s32 nwake;
+    s32 i;
+
+    if (count <= 0) {
+        return;
+    }
+    if (chunk < 1) {
+        chunk = 1;
+    }
+    // nested calls from inside a job can't wait on the pool they're running on
+    if (nujob_busy != 0) {
+        fn(data, 0, count);
+        return;
+    }
+    if ((nujob_wake == NULL) && (NuJobWorkers > 0)) {
+        NuJobStart();
+    }
+
+    // one chunk isn't worth waking anyone for
+    nwake = (count + chunk - 1) / chunk - 1;
+    if (nwake > nujob_nthreads) {
+        nwake = nujob_nthreads;
+    }
+    if (nwake <= 0) {
+        fn(data, 0, count);
+        return;
+    }
+
+    nujob_fn = fn;
+    nujob_data = data;
+    nujob_count = count;
+    nujob_chunk = chunk;
+    nujob_next = 0;
+    nujob_busy = 1;
+    for (i = 0; i < nwake; i++) {
+        SDL_SemPost(nujob_wake);
+    }
+    NuJobRun();
+    for (i = 0; i < nwake; i++) {
+        SDL_SemWait(nujob_done);
+    }
+    nujob_busy = 0;
+}
+
+void NuJobStagesInit(struct nujobstage_s* stages, s32 count) {
+    s32 i;
+    s32 j;
+
+    if (count > NUJOB_MAXSTAGES) {
+        NuErrorProlog("OpenCrashWOC/code/nucore/nujob.c", __LINE__)("NuJobStagesInit: %d stages, max is %d", count, NUJOB_MAXSTAGES);
+    }
+    for (i = 0; i < count; i++) {
+        stages[i].deps = 0;
+        for (j = 0; j < i; j++) {
+            if (((stages[j].writes & (stages[i].reads | stages[i].writes)) != 0) || ((stages[j].reads & stages[i].writes) != 0)) {
+                stages[i].deps |= 1 << j;
+            }
+        }
+    }
+}
+
+static void NuJobStageCall(struct nujobstage_s* st) {
+    u32 t;
+
+    t = SDL_GetTicks();
+    st->fn();
+    t = SDL_GetTicks() - t;
+    st->ms = (st->runs == 0) ? (float)t : st->ms * 0.95f + (float)t * 0.05f;
+    st->runs++;
+}
+
+// One lane per thread, each keeps taking the first stage whose dependencies are done until all of them are.
+static void NuJobStageLane(void* data, s32 start, s32 end) {
+    struct nujobstage_s* st;
+    u32 all;
+    u32 done;
+    u32 claimed;
+    u32 bit;
+    s32 ismain;
+    s32 i;
+
+    all = (nujob_nstages == 32) ? 0xffffffff : (1 << nujob_nstages) - 1;
+    ismain = (SDL_ThreadID() == nujob_mainid);
+    for (;;) {
+        done = (u32)NuAtomicLoad32(&nujob_finished);
+        if (done == all) {
+            break;
+        }
+        claimed = (u32)NuAtomicLoad32(&nujob_claimed);
+        for (i = 0; i < nujob_nstages; i++) {
+            st = &nujob_stages[i];
+            bit = 1 << i;
+            if (((claimed & bit) != 0) || ((st->deps & ~done) != 0)) {
+                continue;
+            }
+            if (((st->flags & NUJOBSTAGE_MAINTHREAD) != 0) && (ismain == 0)) {
+                continue;
+            }
+            break;
+        }
+        if (i == nujob_nstages) {
+            // finished is only ever changed before the broadcast, so checking it under the lock can't miss one
+            SDL_LockMutex(nujob_stagelock);
+            if ((u32)NuAtomicLoad32(&nujob_finished) == done) {
+                SDL_CondWait(nujob_stagecond, nujob_stagelock);
+            }
+            SDL_UnlockMutex(nujob_stagelock);
+            continue;
+        }
+        if ((u32)NuAtomicCas32(&nujob_claimed, claimed, claimed | bit) != claimed) {
+            continue;
+        }
+        NuJobStageCall(st);
+        do {
+            done = (u32)NuAtomicLoad32(&nujob_finished);
+        } while ((u32)NuAtomicCas32(&nujob_finished, done, done | bit) != done);
+        SDL_LockMutex(nujob_stagelock);
+        SDL_CondBroadcast(nujob_stagecond);
+        SDL_UnlockMutex(nujob_stagelock);
+    }
+}
+
+void NuJobRunStages(struct nujobstage_s* stages, s32 count) {
+    s32 lanes;
+
+    if (count <= 0) {
+        return;
+    }
+    if (nujob_stagelock == NULL) {
+        nujob_stagelock = SDL_CreateMutex();
+        nujob_stagecond = SDL_CreateCond();
+        if ((nujob_stagelock == NULL) || (nujob_stagecond == NULL)) {
+            NuErrorProlog("OpenCrashWOC/code/nucore/nujob.c", __LINE__)("NuJobRunStages: can't create the stage lock");
+        }
+    }
+    nujob_stages = stages;
+    nujob_nstages = count;
+    nujob_claimed = 0;
+    nujob_finished = 0;
+    nujob_mainid = SDL_ThreadID();
+
+    // the caller always ends up with a lane of its own, so main thread stages can't stall
+    lanes = NuJobWorkers + 1;
+    if (lanes > NUJOB_MAXWORKERS + 1) {
+        lanes = NUJOB_MAXWORKERS + 1;
+    }
+    NuJobParallelFor(NuJobStageLane, NULL, lanes, 1);
+    nujob_stages = NULL;
+}
+
+void NuJobStagesReport(struct nujobstage_s* stages, s32 count) {
+    float total;
+    s32 i;
+
+    total = 0.0f;
+    for (i = 0; i < count; i++) {
+        printf("%-12s %6.2f ms\n", stages[i].name, stages[i].ms);
+        total += stages[i].ms;
+    }
+    printf("%-12s %6.2f ms\n", "total", total);
+}
+
+void NuJobClose(void) {
+    s32 i;
+
+    if (nujob_stagelock != NULL) {
+        SDL_DestroyCond(nujob_stagecond);
+        SDL_DestroyMutex(nujob_stagelock);
+        nujob_stagecond = NULL;
+        nujob_stagelock = NULL;
+    }
+    if (nujob_wake == NULL) {
+        return;
+    }
+    nujob_quit = 1;
+    for (i = 0; i < nujob_nthreads; i++) {
+        SDL_SemPost(nujob_wake);
+    }
+    for (i = 0; i < nujob_nthreads; i++) {
+        SDL_WaitThread(nujob_thread[i], NULL);
+        nujob_thread[i] = NULL;
+    }
+    SDL_DestroySemaphore(nujob_wake);
+    SDL_DestroySemaphore(nujob_done);
+    nujob_wake = NULL;
+    nujob_done = NULL;
+    nujob_nthreads = 0;
+}
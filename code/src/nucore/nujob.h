@@ -0,0 +1,52 @@
+#ifndef NUJOB_H
+#define NUJOB_H
+
+#include "../types.h"
+
+/*
+  Worker pool for spreading independent per item work over threads.
+  NuJobParallelFor hands out [start, end) ranges of up to chunk items to the workers and the calling thread,
+  and returns once every item is done. Call it from the main thread only, a call made from inside a job runs inline.
+
+  NuJobRunStages runs a list of update stages on the same pool. Each stage declares the resources it reads and writes
+  as bitmasks, a stage waits for every earlier stage it conflicts with, so dependent stages keep their list order and
+  independent ones overlap.
+*/
+
+typedef void (*nujobfn_t)(void* data, s32 start, s32 end);
+
+// Worker threads started on first use, 0 runs everything on the calling thread.
+extern s32 NuJobWorkers;
+
+// Run fn over items 0 to count - 1 in chunks of chunk items.
+void NuJobParallelFor(nujobfn_t fn, void* data, s32 count, s32 chunk);
+
+#define NUJOB_MAXSTAGES 32
+
+// Stage must run on the thread calling NuJobRunStages (sound, pads, anything not thread safe).
+#define NUJOBSTAGE_MAINTHREAD 1
+
+struct nujobstage_s {
+    char* name;
+    void (*fn)(void);
+    u32 reads;
+    u32 writes;
+    s32 flags;
+    u32 deps;   // earlier stages this one waits for, set by NuJobStagesInit
+    float ms;   // smoothed run time
+    s32 runs;
+};
+
+// Work out the dependencies, call again if reads, writes or the order change.
+void NuJobStagesInit(struct nujobstage_s* stages, s32 count);
+
+// Run every stage once and return when they're all done.
+void NuJobRunStages(struct nujobstage_s* stages, s32 count);
+
+// Print the smoothed time of each stage.
+void NuJobStagesReport(struct nujobstage_s* stages, s32 count);
+
+// Stop the worker threads, the next NuJobParallelFor starts them again.
+void NuJobClose(void);
+
+#endif // !NUJOB_H
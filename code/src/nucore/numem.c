@@ -3,6 +3,9 @@
 #include "numem.h"
 #include "nuerror.h"
 #include "nucoretypes.h";
+#include "../../include/SDL/SDL_thread.h"
+#include "nuatomic.h"
+#include <stdint.h>
 
 struct memexternal_s memext;
 extern s32 highallocaddr = 0;
@@ -18,6 +21,189 @@ struct memexternal_s *memexternal;
 
 #define ROUND_UP(x, align) (((x) + (align)-1) & (-(align)))
 
+// Heap allocations are tracked in a side table (pointer -> size and tag) so NuMemFree can credit the right tag.
+#define NUMEMTAG_TABLESIZE 8192
+#define NUMEMTAG_STACKSIZE 16
+
+struct numemtagentry_s
+{
+    void* ptr;
+    s32 size;
+    s32 tag;
+};
+
+struct numemtagstats_s numemtagstats[NUMEMTAG_COUNT];
+static struct numemtagentry_s memtagtable[NUMEMTAG_TABLESIZE];
+static s32 memtagcount;
+static s32 memtaglost;
+static volatile s32 memtagforeign;
+static u32 memtagthread;
+static s32 memtagstack[NUMEMTAG_STACKSIZE];
+static s32 memtagsp;
+static s32 memtagmark;
+static union variptr_u* memtagsuperptr;
+static union variptr_u* memtagsuperbase;
+static union variptr_u* memtagsuperend;
+static char* memtagnames[NUMEMTAG_COUNT] = {
+    "misc", "scene", "texture", "anim", "terrain", "debris", "audio", "cutscene"
+};
+
+static s32 NuMemTagSlot(void* ptr) {
+    return ((u32)(uintptr_t)ptr >> 4) * 0x9e3779b1 >> (32 - 13);
+}
+
+// The tag state is main thread only. Job workers allocate and free untracked, see NuMemTagMain.
+static s32 NuMemTagMain(void) {
+    return (memtagthread == 0) || (SDL_ThreadID() == memtagthread);
+}
+
+static void NuMemTagCheckMain(char* name) {
+    if (!NuMemTagMain()) {
+        NuErrorProlog("OpenCrashWOC/code/nucore/numem.c", __LINE__)("%s : called off the main thread", name);
+    }
+}
+
+static void NuMemTagAdd(void* ptr, s32 size) {
+    struct numemtagstats_s* st;
+    s32 i;
+
+    if (!NuMemTagMain()) {
+        NuAtomicAdd32(&memtagforeign, 1);
+        return;
+    }
+    st = &numemtagstats[memtagstack[memtagsp]];
+    st->heap += size;
+    st->level += size;
+    if (st->heap > st->heappeak) {
+        st->heappeak = st->heap;
+    }
+    if (st->heap > st->levelpeak) {
+        st->levelpeak = st->heap;
+    }
+    if (memtagcount >= NUMEMTAG_TABLESIZE - (NUMEMTAG_TABLESIZE / 4)) {
+        // Table is full, the bytes stay charged to the tag for good.
+        memtaglost++;
+        return;
+    }
+    for (i = NuMemTagSlot(ptr); memtagtable[i].ptr != NULL; i = (i + 1) & (NUMEMTAG_TABLESIZE - 1)) {}
+    memtagtable[i].ptr = ptr;
+    memtagtable[i].size = size;
+    memtagtable[i].tag = memtagstack[memtagsp];
+    memtagcount++;
+}
+
+static void NuMemTagRemove(void* ptr) {
+    s32 i;
+    s32 j;
+    s32 k;
+
+    if ((ptr == NULL) || !NuMemTagMain()) {
+        return;
+    }
+    for (i = NuMemTagSlot(ptr); memtagtable[i].ptr != ptr; i = (i + 1) & (NUMEMTAG_TABLESIZE - 1)) {
+        if (memtagtable[i].ptr == NULL) {
+            return;
+        }
+    }
+    numemtagstats[memtagtable[i].tag].heap -= memtagtable[i].size;
+    memtagcount--;
+    // Shift later entries of the probe run back so lookups never need tombstones.
+    for (j = (i + 1) & (NUMEMTAG_TABLESIZE - 1); memtagtable[j].ptr != NULL; j = (j + 1) & (NUMEMTAG_TABLESIZE - 1)) {
+        k = NuMemTagSlot(memtagtable[j].ptr);
+        if (((j > i) && ((k <= i) || (k > j))) || ((j < i) && ((k <= i) && (k > j)))) {
+            memtagtable[i] = memtagtable[j];
+            i = j;
+        }
+    }
+    memtagtable[i].ptr = NULL;
+}
+
+// Charge what the superbuffer has grown by since the last mark to the current tag.
+static void NuMemTagFlushSuper(void) {
+    s32 now;
+
+    if (memtagsuperptr == NULL) {
+        return;
+    }
+    now = (s32)(memtagsuperptr->u8 - memtagsuperbase->u8);
+    if (now > memtagmark) {
+        numemtagstats[memtagstack[memtagsp]].super += now - memtagmark;
+    }
+    memtagmark = now;
+}
+
+void NuMemPushTag(enum numemtag_e tag) {
+    NuMemTagCheckMain("NuMemPushTag");
+    NuMemTagFlushSuper();
+    if (memtagsp < NUMEMTAG_STACKSIZE - 1) {
+        memtagsp++;
+    }
+    else {
+        NuErrorProlog("OpenCrashWOC/code/nucore/numem.c", __LINE__)("NuMemPushTag : tag stack overflow");
+    }
+    memtagstack[memtagsp] = tag;
+}
+
+void NuMemPopTag(void) {
+    NuMemTagCheckMain("NuMemPopTag");
+    NuMemTagFlushSuper();
+    if (memtagsp > 0) {
+        memtagsp--;
+    }
+}
+
+void NuMemTagSetSuper(union variptr_u* ptr, union variptr_u* base, union variptr_u* end) {
+    // The first call comes from the main thread at startup, it owns the tag state from then on.
+    if (memtagthread == 0) {
+        memtagthread = SDL_ThreadID();
+    }
+    NuMemTagCheckMain("NuMemTagSetSuper");
+    memtagsuperptr = ptr;
+    memtagsuperbase = base;
+    memtagsuperend = end;
+    memtagmark = (ptr != NULL) ? (s32)(ptr->u8 - base->u8) : 0;
+}
+
+void NuMemTagLevelReset(void) {
+    s32 i;
+
+    NuMemTagCheckMain("NuMemTagLevelReset");
+    for (i = 0; i < NUMEMTAG_COUNT; i++) {
+        numemtagstats[i].level = 0;
+        numemtagstats[i].levelpeak = numemtagstats[i].heap;
+        numemtagstats[i].super = 0;
+    }
+    if (memtagsuperptr != NULL) {
+        memtagmark = (s32)(memtagsuperptr->u8 - memtagsuperbase->u8);
+    }
+}
+
+void NuMemTagDump(char* title) {
+    s32 i;
+    s32 used;
+    s32 size;
+
+    NuMemTagFlushSuper();
+    printf("NuMemTagDump: %s\n", title);
+    printf("  %-10s %10s %10s %10s %10s %10s\n", "tag", "heap", "heappeak", "level", "levelpeak", "super");
+    for (i = 0; i < NUMEMTAG_COUNT; i++) {
+        printf("  %-10s %10d %10d %10d %10d %10d\n", memtagnames[i], numemtagstats[i].heap, numemtagstats[i].heappeak,
+               numemtagstats[i].level, numemtagstats[i].levelpeak, numemtagstats[i].super);
+    }
+    if (memtagsuperptr != NULL) {
+        used = (s32)(memtagsuperptr->u8 - memtagsuperbase->u8);
+        size = (s32)(memtagsuperend->u8 - memtagsuperbase->u8);
+        printf("  superbuffer %d / %d bytes used, %d free (%.1f%%)\n", used, size, size - used,
+               (size != 0) ? ((float)used * 100.0f / (float)size) : 0.0f);
+    }
+    if (memtaglost != 0) {
+        printf("  %d heap allocations untracked, side table full\n", memtaglost);
+    }
+    if (memtagforeign != 0) {
+        printf("  %d heap allocations untracked, made off the main thread\n", memtagforeign);
+    }
+}
+
 //MATCH NGC
 void NuMemSetExternal(union variptr_u* ptr, union variptr_u* end) {
 	if (ptr != NULL) {
@@ -30,7 +216,6 @@ void NuMemSetExternal(union variptr_u* ptr, union variptr_u* end) {
     return;
 }
 
-//MATCH NGC
 void* NuMemAlloc(s32 size) {
     void* ret;
 
@@ -58,6 +243,7 @@ void* NuMemAlloc(s32 size) {
 
         // Clear buffer
         memset(ret, 0, size);
+        NuMemTagAdd(ret, size);
 
         // Resize heap?
         end = (s32)ret + size;
@@ -73,6 +259,7 @@ void* NuMemAlloc(s32 size) {
 
 void NuMemFree(void* data)
 {
+	NuMemTagRemove(data);
 	free(data);
 }
 
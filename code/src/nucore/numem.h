@@ -18,6 +18,33 @@ static s32 peakallocaddr;
 static s32 totalloc;
 extern s32 malloced;
 
+// Who memory is being allocated for, set around the loaders with NuMemPushTag / NuMemPopTag.
+// The tag functions are main thread only, NuMemAlloc / NuMemFree from a job worker are left untracked.
+enum numemtag_e
+{
+    NUMEMTAG_MISC = 0,
+    NUMEMTAG_SCENE = 1,
+    NUMEMTAG_TEXTURE = 2,
+    NUMEMTAG_ANIM = 3,
+    NUMEMTAG_TERRAIN = 4,
+    NUMEMTAG_DEBRIS = 5,
+    NUMEMTAG_AUDIO = 6,
+    NUMEMTAG_CUTSCENE = 7,
+    NUMEMTAG_COUNT = 8
+};
+
+// Size: 0x14
+struct numemtagstats_s
+{
+    s32 heap;       // heap bytes held now
+    s32 heappeak;
+    s32 level;      // heap bytes allocated since the last NuMemTagLevelReset
+    s32 levelpeak;  // most heap bytes held at once since then
+    s32 super;      // superbuffer bytes used since then
+};
+
+extern struct numemtagstats_s numemtagstats[NUMEMTAG_COUNT];
+
 
 
 //void memset(void*, int, int, ...); // the crclr at 24 means memset takes varargs
@@ -37,4 +64,17 @@ void* malloc_x(s32 size);
 // Free memory.
 void free_x(void* data);
 
+// Charge allocations to tag until the matching pop.
+void NuMemPushTag(enum numemtag_e tag);
+void NuMemPopTag(void);
+
+// Watch a bump buffer so what each tag takes out of it is recorded too.
+void NuMemTagSetSuper(union variptr_u* ptr, union variptr_u* base, union variptr_u* end);
+
+// Start counting a new level.
+void NuMemTagLevelReset(void);
+
+// Print the per tag totals and the superbuffer occupancy.
+void NuMemTagDump(char* title);
+
 #endif // !NUMEM_H
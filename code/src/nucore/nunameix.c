@@ -0,0 +1,154 @@
+#include "nunameix.h"
+#include "numem.h"
+#include <string.h>
+#include <stdlib.h>
+
+#define NUNAMEIX_FOLD(c) ((((c) >= 'A') && ((c) <= 'Z')) ? ((c) + ('a' - 'A')) : (c))
+
+static u32 NuNameIxHash(char* s) {
+    u32 h;
+    u8 c;
+
+    // FNV-1a over the folded bytes
+    h = 0x811c9dc5;
+    while ((c = *s++) != 0) {
+        h = (h ^ NUNAMEIX_FOLD(c)) * 0x01000193;
+    }
+    return h;
+}
+
+// strncasecmp that only folds ASCII, so the hash and the sort agree with it everywhere.
+static s32 NuNameIxCmp(char* a, char* b, s32 len) {
+    s32 ca;
+    s32 cb;
+
+    for (; len > 0; len--) {
+        ca = NUNAMEIX_FOLD((u8)*a);
+        cb = NUNAMEIX_FOLD((u8)*b);
+        if ((ca != cb) || (ca == 0)) {
+            return ca - cb;
+        }
+        a++;
+        b++;
+    }
+    return 0;
+}
+
+static char** nunameix_sortnames;
+
+static int NuNameIxSortCmp(const void* a, const void* b) {
+    s32 ia;
+    s32 ib;
+    s32 d;
+
+    ia = *(const s32*)a;
+    ib = *(const s32*)b;
+    d = NuNameIxCmp(nunameix_sortnames[ia], nunameix_sortnames[ib], 0x7fffffff);
+    return (d != 0) ? d : ia - ib;
+}
+
+struct nunameix_s* NuNameIxCreate(char** names, s32 count) {
+    struct nunameix_s* ix;
+    s32 size;
+    s32 i;
+    s32 slot;
+
+    size = 16;
+    while (size < count * 2) {
+        size <<= 1;
+    }
+    ix = (struct nunameix_s*)NuMemAlloc(sizeof(struct nunameix_s) + (size + count) * sizeof(s32));
+    if (ix == NULL) {
+        return NULL;
+    }
+    ix->count = count;
+    ix->names = names;
+    ix->mask = size - 1;
+    ix->hash = (s32*)(ix + 1);
+    ix->sorted = ix->hash + size;
+
+    // linear probing in index order keeps equal names in index order along the probe
+    memset(ix->hash, 0xff, size * sizeof(s32));
+    for (i = 0; i < count; i++) {
+        ix->sorted[i] = i;
+        slot = NuNameIxHash(names[i]) & ix->mask;
+        while (ix->hash[slot] != -1) {
+            slot = (slot + 1) & ix->mask;
+        }
+        ix->hash[slot] = i;
+    }
+
+    nunameix_sortnames = names;
+    qsort(ix->sorted, count, sizeof(s32), NuNameIxSortCmp);
+    nunameix_sortnames = NULL;
+    return ix;
+}
+
+void NuNameIxDestroy(struct nunameix_s* ix) {
+    if (ix != NULL) {
+        NuMemFree(ix);
+    }
+}
+
+s32 NuNameIxFind(struct nunameix_s* ix, char* name) {
+    s32 slot;
+    s32 i;
+
+    slot = NuNameIxHash(name) & ix->mask;
+    while ((i = ix->hash[slot]) != -1) {
+        if (NuNameIxCmp(ix->names[i], name, 0x7fffffff) == 0) {
+            return i;
+        }
+        slot = (slot + 1) & ix->mask;
+    }
+    return -1;
+}
+
+s32 NuNameIxPrefixRange(struct nunameix_s* ix, char* prefix, s32 len, s32* first) {
+    s32 lo;
+    s32 hi;
+    s32 mid;
+    s32 start;
+
+    // first name not below the prefix, then first name past everything starting with it
+    lo = 0;
+    hi = ix->count;
+    while (lo < hi) {
+        mid = (lo + hi) >> 1;
+        if (NuNameIxCmp(ix->names[ix->sorted[mid]], prefix, len) < 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    start = lo;
+    hi = ix->count;
+    while (lo < hi) {
+        mid = (lo + hi) >> 1;
+        if (NuNameIxCmp(ix->names[ix->sorted[mid]], prefix, len) == 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    *first = start;
+    return lo - start;
+}
+
+s32 NuNameIxFindPrefix(struct nunameix_s* ix, char* prefix) {
+    s32 first;
+    s32 n;
+    s32 best;
+    s32 i;
+
+    n = NuNameIxPrefixRange(ix, prefix, strlen(prefix), &first);
+    best = -1;
+    for (i = first; i < first + n; i++) {
+        if ((best == -1) || (ix->sorted[i] < best)) {
+            best = ix->sorted[i];
+        }
+    }
+    return best;
+}
@@ -0,0 +1,35 @@
+#ifndef NUNAMEIX_H
+#define NUNAMEIX_H
+
+#include "../types.h"
+
+/*
+  Case insensitive lookup over a fixed array of names, for the scene tables searched by name at level setup.
+  Exact lookups go through an open addressed hash of the folded names, prefix lookups through the names sorted
+  folded. Both return the lowest matching index, the same result as a front to back strcasecmp scan.
+*/
+
+// Size: 0x14
+struct nunameix_s {
+    s32 count;
+    char** names;   // the caller's strings, not copied
+    s32 mask;       // hash size - 1
+    s32* hash;      // name index or -1
+    s32* sorted;    // name indices by folded name, then index
+};
+
+// Build an index over names[0] to names[count - 1], NULL if there's no memory for it.
+struct nunameix_s* NuNameIxCreate(char** names, s32 count);
+
+void NuNameIxDestroy(struct nunameix_s* ix);
+
+// Lowest index whose name equals name ignoring case, or -1.
+s32 NuNameIxFind(struct nunameix_s* ix, char* name);
+
+// Names starting with the first len chars of prefix, ignoring case, are ix->sorted[*first] on, returns how many.
+s32 NuNameIxPrefixRange(struct nunameix_s* ix, char* prefix, s32 len, s32* first);
+
+// Lowest index whose name starts with prefix ignoring case, or -1.
+s32 NuNameIxFindPrefix(struct nunameix_s* ix, char* prefix);
+
+#endif // !NUNAMEIX_H
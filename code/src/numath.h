@@ -7,6 +7,8 @@
 #include "numath/nuplane.h"
 #include "numath/nuquat.h"
 #include "numath/nurand.h"
+#include "numath/nurng.h"
+#include "numath/nusimd.h"
 #include "numath/nutrig.h"
 #include "numath/nuvec.h"
 #include "numath/nuvec4.h"
@@ -0,0 +1,173 @@
+#include "nurng.h"
+#include "nusimd.h"
+
+static struct nurng_s NuRngStreams[NURNG_STREAMS];
+static s32 NuRngSeeded[NURNG_STREAMS];
+
+#define NURNG_ROTL(a, n) NuI4Or(NuI4Sll((a), (n)), NuI4Srl((a), 32 - (n)))
+
+// One xoshiro128++ step on all four lanes, r gets the outputs.
+#define NURNG_STEP(r, s0, s1, s2, s3)             \
+    {                                             \
+        nui4 t;                                   \
+        r = NuI4Add(NURNG_ROTL(NuI4Add(s0, s3), 7), s0); \
+        t = NuI4Sll(s1, 9);                       \
+        s2 = NuI4Xor(s2, s0);                     \
+        s3 = NuI4Xor(s3, s1);                     \
+        s1 = NuI4Xor(s1, s2);                     \
+        s0 = NuI4Xor(s0, s3);                     \
+        s2 = NuI4Xor(s2, t);                      \
+        s3 = NURNG_ROTL(s3, 11);                  \
+    }
+
+// Top 23 bits as the mantissa of a float in [1, 2).
+#define NURNG_TOFLOAT(r) NuI4AsF4(NuI4Or(NuI4Srl(r, 9), NuI4Set1(0x3f800000)))
+
+static u64 NuRngSplitMix(u64* x) {
+    u64 z;
+
+    *x += 0x9e3779b97f4a7c15ULL;
+    z = *x;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+void NuRngSeed(struct nurng_s* rng, u32 seed, s32 id) {
+    u64 x;
+    u64 v;
+    s32 i;
+    s32 lane;
+
+    x = ((u64)(u32)id << 32) | seed;
+    for (lane = 0; lane < 4; lane++) {
+        for (i = 0; i < 4; i += 2) {
+            v = NuRngSplitMix(&x);
+            rng->s[i][lane] = (u32)v;
+            rng->s[i + 1][lane] = (u32)(v >> 32);
+        }
+        if ((rng->s[0][lane] | rng->s[1][lane] | rng->s[2][lane] | rng->s[3][lane]) == 0) {
+            rng->s[0][lane] = 1;
+        }
+    }
+    rng->nbuf = 0;
+}
+
+void NuRngSeedAll(u32 seed) {
+    s32 i;
+
+    for (i = 0; i < NURNG_STREAMS; i++) {
+        NuRngSeed(&NuRngStreams[i], seed, i);
+        NuRngSeeded[i] = 1;
+    }
+}
+
+struct nurng_s* NuRngStream(s32 ix) {
+    if (NuRngSeeded[ix] == 0) {
+        NuRngSeed(&NuRngStreams[ix], NURNG_DEFAULTSEED, ix);
+        NuRngSeeded[ix] = 1;
+    }
+    return &NuRngStreams[ix];
+}
+
+static void NuRngRefill(struct nurng_s* rng) {
+    nui4 s0;
+    nui4 s1;
+    nui4 s2;
+    nui4 s3;
+    nui4 r;
+
+    s0 = NuI4LoadU(rng->s[0]);
+    s1 = NuI4LoadU(rng->s[1]);
+    s2 = NuI4LoadU(rng->s[2]);
+    s3 = NuI4LoadU(rng->s[3]);
+    NURNG_STEP(r, s0, s1, s2, s3);
+    NuI4StoreU(rng->buf, r);
+    NuI4StoreU(rng->s[0], s0);
+    NuI4StoreU(rng->s[1], s1);
+    NuI4StoreU(rng->s[2], s2);
+    NuI4StoreU(rng->s[3], s3);
+    rng->nbuf = 4;
+}
+
+u32 NuRngU32(struct nurng_s* rng) {
+    if (rng->nbuf == 0) {
+        NuRngRefill(rng);
+    }
+    return rng->buf[4 - rng->nbuf--];
+}
+
+f32 NuRngFloat(struct nurng_s* rng) {
+    union {
+        u32 u;
+        f32 f;
+    } v;
+
+    v.u = (NuRngU32(rng) >> 9) | 0x3f800000;
+    return v.f - 1.0f;
+}
+
+void NuRngFillU32(struct nurng_s* rng, u32* out, s32 n) {
+    nui4 s0;
+    nui4 s1;
+    nui4 s2;
+    nui4 s3;
+    nui4 r;
+
+    // whatever is buffered goes first so the sequence is the same as single draws
+    for (; (n > 0) && (rng->nbuf > 0); n--) {
+        *out++ = NuRngU32(rng);
+    }
+    if (n >= 4) {
+        s0 = NuI4LoadU(rng->s[0]);
+        s1 = NuI4LoadU(rng->s[1]);
+        s2 = NuI4LoadU(rng->s[2]);
+        s3 = NuI4LoadU(rng->s[3]);
+        for (; n >= 4; n -= 4, out += 4) {
+            NURNG_STEP(r, s0, s1, s2, s3);
+            NuI4StoreU(out, r);
+        }
+        NuI4StoreU(rng->s[0], s0);
+        NuI4StoreU(rng->s[1], s1);
+        NuI4StoreU(rng->s[2], s2);
+        NuI4StoreU(rng->s[3], s3);
+    }
+    for (; n > 0; n--) {
+        *out++ = NuRngU32(rng);
+    }
+}
+
+void NuRngFillFloat(struct nurng_s* rng, f32* out, s32 n, f32 lo, f32 hi) {
+    nui4 s0;
+    nui4 s1;
+    nui4 s2;
+    nui4 s3;
+    nui4 r;
+    nuf4 one;
+    nuf4 scale;
+    nuf4 base;
+
+    for (; (n > 0) && (rng->nbuf > 0); n--) {
+        *out++ = NuRngFloat(rng) * (hi - lo) + lo;
+    }
+    if (n >= 4) {
+        one = NuF4Set1(1.0f);
+        scale = NuF4Set1(hi - lo);
+        base = NuF4Set1(lo);
+        s0 = NuI4LoadU(rng->s[0]);
+        s1 = NuI4LoadU(rng->s[1]);
+        s2 = NuI4LoadU(rng->s[2]);
+        s3 = NuI4LoadU(rng->s[3]);
+        for (; n >= 4; n -= 4, out += 4) {
+            NURNG_STEP(r, s0, s1, s2, s3);
+            NuF4StoreU(out, NuF4Madd(NuF4Sub(NURNG_TOFLOAT(r), one), scale, base));
+        }
+        NuI4StoreU(rng->s[0], s0);
+        NuI4StoreU(rng->s[1], s1);
+        NuI4StoreU(rng->s[2], s2);
+        NuI4StoreU(rng->s[3], s3);
+    }
+    for (; n > 0; n--) {
+        *out++ = NuRngFloat(rng) * (hi - lo) + lo;
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef NURNG_H
+#define NURNG_H
+
+#include "../types.h"
+
+/*
+  Random number streams for the game code. Each stream is four interleaved xoshiro128++ generators stepped together
+  with nui4 ops, so bulk fills make four numbers a step and single draws come out of the same sequence.
+  A stream is only safe on one thread at a time, give each subsystem that can run on the job pool its own.
+*/
+
+#define NURNG_GAME 0    // randy, AI and general game logic
+#define NURNG_DEBRIS 1  // debris emitters and creature spawns, main thread only
+#define NURNG_FX 2      // other effects
+#define NURNG_STREAMS 3
+
+#define NURNG_DEFAULTSEED 0x3039
+
+// Size: 0x54
+struct nurng_s {
+    u32 s[4][4];  // state word, lane
+    u32 buf[4];
+    s32 nbuf;
+};
+
+// Seed a stream, streams with the same seed and a different id don't overlap.
+void NuRngSeed(struct nurng_s* rng, u32 seed, s32 id);
+
+// Reseed all the named streams.
+void NuRngSeedAll(u32 seed);
+
+// Named stream, seeded with NURNG_DEFAULTSEED on first use.
+struct nurng_s* NuRngStream(s32 ix);
+
+u32 NuRngU32(struct nurng_s* rng);
+
+// 0 to 1, 1 excluded.
+f32 NuRngFloat(struct nurng_s* rng);
+
+void NuRngFillU32(struct nurng_s* rng, u32* out, s32 n);
+
+// n floats from lo to hi, hi excluded.
+void NuRngFillFloat(struct nurng_s* rng, f32* out, s32 n, f32 lo, f32 hi);
+
+#endif // !NURNG_H
@@ -0,0 +1,151 @@
+#ifndef NUSIMD_H
+#define NUSIMD_H
+
+#include "../types.h"
+#include <string.h>
+
+/*
+  Four wide float helpers used by the batched PC paths (culling, deformation, particles...).
+  SSE2 on x86, NEON on ARM and a plain C fallback everywhere else, all with the same results.
+  Loads and stores expect 16 byte aligned data unless the name ends in U.
+  nui4 is four u32 lanes for texel and random number work. The shift counts must be constants.
+*/
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define NUSIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define NUSIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(NUSIMD_SSE2)
+
+typedef __m128 nuf4;
+typedef __m128 nuf4mask;
+
+static inline nuf4 NuF4Load(const f32* p) { return _mm_load_ps(p); }
+static inline nuf4 NuF4LoadU(const f32* p) { return _mm_loadu_ps(p); }
+static inline void NuF4Store(f32* p, nuf4 a) { _mm_store_ps(p, a); }
+static inline void NuF4StoreU(f32* p, nuf4 a) { _mm_storeu_ps(p, a); }
+static inline nuf4 NuF4Set1(f32 f) { return _mm_set1_ps(f); }
+static inline nuf4 NuF4Add(nuf4 a, nuf4 b) { return _mm_add_ps(a, b); }
+static inline nuf4 NuF4Sub(nuf4 a, nuf4 b) { return _mm_sub_ps(a, b); }
+static inline nuf4 NuF4Mul(nuf4 a, nuf4 b) { return _mm_mul_ps(a, b); }
+static inline nuf4 NuF4Madd(nuf4 a, nuf4 b, nuf4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+static inline nuf4 NuF4Min(nuf4 a, nuf4 b) { return _mm_min_ps(a, b); }
+static inline nuf4 NuF4Max(nuf4 a, nuf4 b) { return _mm_max_ps(a, b); }
+static inline nuf4 NuF4Abs(nuf4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+static inline nuf4mask NuF4CmpLt(nuf4 a, nuf4 b) { return _mm_cmplt_ps(a, b); }
+static inline nuf4mask NuF4CmpNe(nuf4 a, nuf4 b) { return _mm_cmpneq_ps(a, b); }
+static inline nuf4mask NuF4MaskOr(nuf4mask a, nuf4mask b) { return _mm_or_ps(a, b); }
+static inline nuf4mask NuF4MaskAnd(nuf4mask a, nuf4mask b) { return _mm_and_ps(a, b); }
+static inline nuf4 NuF4Select(nuf4mask m, nuf4 a, nuf4 b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+static inline s32 NuF4MaskBits(nuf4mask m) { return _mm_movemask_ps(m); }
+
+typedef __m128i nui4;
+
+static inline nui4 NuI4LoadU(const void* p) { return _mm_loadu_si128((const __m128i*)p); }
+static inline void NuI4StoreU(void* p, nui4 a) { _mm_storeu_si128((__m128i*)p, a); }
+static inline nui4 NuI4Set1(u32 u) { return _mm_set1_epi32((s32)u); }
+static inline nui4 NuI4And(nui4 a, nui4 b) { return _mm_and_si128(a, b); }
+static inline nui4 NuI4Or(nui4 a, nui4 b) { return _mm_or_si128(a, b); }
+static inline nui4 NuI4CmpEq(nui4 a, nui4 b) { return _mm_cmpeq_epi32(a, b); }
+static inline nui4 NuI4Select(nui4 m, nui4 a, nui4 b) { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+static inline nui4 NuI4Add(nui4 a, nui4 b) { return _mm_add_epi32(a, b); }
+static inline nui4 NuI4Xor(nui4 a, nui4 b) { return _mm_xor_si128(a, b); }
+static inline nuf4 NuI4AsF4(nui4 a) { return _mm_castsi128_ps(a); }
+#define NuI4Srl(a, n) _mm_srli_epi32((a), (n))
+#define NuI4Sll(a, n) _mm_slli_epi32((a), (n))
+
+#elif defined(NUSIMD_NEON)
+
+typedef float32x4_t nuf4;
+typedef uint32x4_t nuf4mask;
+
+static inline nuf4 NuF4Load(const f32* p) { return vld1q_f32(p); }
+static inline nuf4 NuF4LoadU(const f32* p) { return vld1q_f32(p); }
+static inline void NuF4Store(f32* p, nuf4 a) { vst1q_f32(p, a); }
+static inline void NuF4StoreU(f32* p, nuf4 a) { vst1q_f32(p, a); }
+static inline nuf4 NuF4Set1(f32 f) { return vdupq_n_f32(f); }
+static inline nuf4 NuF4Add(nuf4 a, nuf4 b) { return vaddq_f32(a, b); }
+static inline nuf4 NuF4Sub(nuf4 a, nuf4 b) { return vsubq_f32(a, b); }
+static inline nuf4 NuF4Mul(nuf4 a, nuf4 b) { return vmulq_f32(a, b); }
+static inline nuf4 NuF4Madd(nuf4 a, nuf4 b, nuf4 c) { return vmlaq_f32(c, a, b); }
+static inline nuf4 NuF4Min(nuf4 a, nuf4 b) { return vminq_f32(a, b); }
+static inline nuf4 NuF4Max(nuf4 a, nuf4 b) { return vmaxq_f32(a, b); }
+static inline nuf4 NuF4Abs(nuf4 a) { return vabsq_f32(a); }
+static inline nuf4mask NuF4CmpLt(nuf4 a, nuf4 b) { return vcltq_f32(a, b); }
+static inline nuf4mask NuF4CmpNe(nuf4 a, nuf4 b) { return vmvnq_u32(vceqq_f32(a, b)); }
+static inline nuf4mask NuF4MaskOr(nuf4mask a, nuf4mask b) { return vorrq_u32(a, b); }
+static inline nuf4mask NuF4MaskAnd(nuf4mask a, nuf4mask b) { return vandq_u32(a, b); }
+static inline nuf4 NuF4Select(nuf4mask m, nuf4 a, nuf4 b) { return vbslq_f32(m, a, b); }
+static inline s32 NuF4MaskBits(nuf4mask m) {
+    static const u32 bits[4] = { 1, 2, 4, 8 };
+    uint32x4_t v = vandq_u32(m, vld1q_u32(bits));
+    uint32x2_t s = vadd_u32(vget_low_u32(v), vget_high_u32(v));
+    return (s32)(vget_lane_u32(s, 0) + vget_lane_u32(s, 1));
+}
+
+typedef uint32x4_t nui4;
+
+static inline nui4 NuI4LoadU(const void* p) { return vreinterpretq_u32_u8(vld1q_u8((const u8*)p)); }
+static inline void NuI4StoreU(void* p, nui4 a) { vst1q_u8((u8*)p, vreinterpretq_u8_u32(a)); }
+static inline nui4 NuI4Set1(u32 u) { return vdupq_n_u32(u); }
+static inline nui4 NuI4And(nui4 a, nui4 b) { return vandq_u32(a, b); }
+static inline nui4 NuI4Or(nui4 a, nui4 b) { return vorrq_u32(a, b); }
+static inline nui4 NuI4CmpEq(nui4 a, nui4 b) { return vceqq_u32(a, b); }
+static inline nui4 NuI4Select(nui4 m, nui4 a, nui4 b) { return vbslq_u32(m, a, b); }
+static inline nui4 NuI4Add(nui4 a, nui4 b) { return vaddq_u32(a, b); }
+static inline nui4 NuI4Xor(nui4 a, nui4 b) { return veorq_u32(a, b); }
+static inline nuf4 NuI4AsF4(nui4 a) { return vreinterpretq_f32_u32(a); }
+#define NuI4Srl(a, n) vshrq_n_u32((a), (n))
+#define NuI4Sll(a, n) vshlq_n_u32((a), (n))
+
+#else
+
+// Size: 0x10
+typedef struct { f32 v[4]; } nuf4;
+// Size: 0x10
+typedef struct { u32 v[4]; } nuf4mask;
+
+static inline nuf4 NuF4Load(const f32* p) { nuf4 r; s32 i; for (i = 0; i < 4; i++) { r.v[i] = p[i]; } return r; }
+static inline nuf4 NuF4LoadU(const f32* p) { return NuF4Load(p); }
+static inline void NuF4Store(f32* p, nuf4 a) { s32 i; for (i = 0; i < 4; i++) { p[i] = a.v[i]; } }
+static inline void NuF4StoreU(f32* p, nuf4 a) { NuF4Store(p, a); }
+static inline nuf4 NuF4Set1(f32 f) { nuf4 r; r.v[0] = r.v[1] = r.v[2] = r.v[3] = f; return r; }
+static inline nuf4 NuF4Add(nuf4 a, nuf4 b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] += b.v[i]; } return a; }
+static inline nuf4 NuF4Sub(nuf4 a, nuf4 b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] -= b.v[i]; } return a; }
+static inline nuf4 NuF4Mul(nuf4 a, nuf4 b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] *= b.v[i]; } return a; }
+static inline nuf4 NuF4Madd(nuf4 a, nuf4 b, nuf4 c) { s32 i; for (i = 0; i < 4; i++) { a.v[i] = a.v[i] * b.v[i] + c.v[i]; } return a; }
+static inline nuf4 NuF4Min(nuf4 a, nuf4 b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] = (a.v[i] < b.v[i]) ? a.v[i] : b.v[i]; } return a; }
+static inline nuf4 NuF4Max(nuf4 a, nuf4 b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] = (a.v[i] > b.v[i]) ? a.v[i] : b.v[i]; } return a; }
+static inline nuf4 NuF4Abs(nuf4 a) { s32 i; for (i = 0; i < 4; i++) { a.v[i] = (a.v[i] < 0.0f) ? -a.v[i] : a.v[i]; } return a; }
+static inline nuf4mask NuF4CmpLt(nuf4 a, nuf4 b) { nuf4mask m; s32 i; for (i = 0; i < 4; i++) { m.v[i] = (a.v[i] < b.v[i]) ? 0xffffffff : 0; } return m; }
+static inline nuf4mask NuF4CmpNe(nuf4 a, nuf4 b) { nuf4mask m; s32 i; for (i = 0; i < 4; i++) { m.v[i] = (a.v[i] != b.v[i]) ? 0xffffffff : 0; } return m; }
+static inline nuf4mask NuF4MaskOr(nuf4mask a, nuf4mask b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] |= b.v[i]; } return a; }
+static inline nuf4mask NuF4MaskAnd(nuf4mask a, nuf4mask b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] &= b.v[i]; } return a; }
+static inline nuf4 NuF4Select(nuf4mask m, nuf4 a, nuf4 b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] = m.v[i] ? a.v[i] : b.v[i]; } return a; }
+static inline s32 NuF4MaskBits(nuf4mask m) { return (m.v[0] & 1) | ((m.v[1] & 1) << 1) | ((m.v[2] & 1) << 2) | ((m.v[3] & 1) << 3); }
+
+// Size: 0x10
+typedef struct { u32 v[4]; } nui4;
+
+static inline nui4 NuI4LoadU(const void* p) { nui4 r; memcpy(r.v, p, sizeof(r.v)); return r; }
+static inline void NuI4StoreU(void* p, nui4 a) { memcpy(p, a.v, sizeof(a.v)); }
+static inline nui4 NuI4Set1(u32 u) { nui4 r; r.v[0] = r.v[1] = r.v[2] = r.v[3] = u; return r; }
+static inline nui4 NuI4And(nui4 a, nui4 b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] &= b.v[i]; } return a; }
+static inline nui4 NuI4Or(nui4 a, nui4 b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] |= b.v[i]; } return a; }
+static inline nui4 NuI4CmpEq(nui4 a, nui4 b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] = (a.v[i] == b.v[i]) ? 0xffffffff : 0; } return a; }
+static inline nui4 NuI4Select(nui4 m, nui4 a, nui4 b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] = (a.v[i] & m.v[i]) | (b.v[i] & ~m.v[i]); } return a; }
+static inline nui4 NuI4Add(nui4 a, nui4 b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] += b.v[i]; } return a; }
+static inline nui4 NuI4Xor(nui4 a, nui4 b) { s32 i; for (i = 0; i < 4; i++) { a.v[i] ^= b.v[i]; } return a; }
+static inline nuf4 NuI4AsF4(nui4 a) { nuf4 r; memcpy(r.v, a.v, sizeof(r.v)); return r; }
+static inline nui4 NuI4SrlV(nui4 a, s32 n) { s32 i; for (i = 0; i < 4; i++) { a.v[i] >>= n; } return a; }
+static inline nui4 NuI4SllV(nui4 a, s32 n) { s32 i; for (i = 0; i < 4; i++) { a.v[i] <<= n; } return a; }
+#define NuI4Srl(a, n) NuI4SrlV((a), (n))
+#define NuI4Sll(a, n) NuI4SllV((a), (n))
+
+#endif
+
+#endif // !NUSIMD_H
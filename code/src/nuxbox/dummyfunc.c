@@ -1,9 +1,10 @@
 #include "../system.h"
 #include "nu3dx/nu3dxtypes.h"
+#include "nuxbox/nuscratch.h"
+#include <stdint.h>
 
 #define MIN(X, Y) (((X) < (Y)) ? (X) : (Y))
 #define MAX(X, Y) (((X) > (Y)) ? (X) : (Y))
-#define ALIGN4(n) (((n) + 3) & ~3)
 
 int maxblend_cntcnt;
 int maxblend_cnt;
@@ -58,12 +59,15 @@ void NuGScnRndr3(struct nugscn_s *scn) {
   return;
 }
 
-//MATCH GCN
 struct nugspline_s * NuSplineFind(struct nugscn_s *scene,char *name) {
   s32 i;
   struct nugspline_s *sp;
 
 
+  if (scene->splineix != NULL) {
+    i = NuNameIxFind(scene->splineix,name);
+    return (i != -1) ? &scene->splines[i] : NULL;
+  }
   sp = scene->splines;
     for (i = 0; i < scene->numsplines; i++) {
       if (strcasecmp(name,sp->name) == 0) {
@@ -74,11 +78,19 @@ struct nugspline_s * NuSplineFind(struct nugscn_s *scene,char *name) {
   return NULL;
 }
 
-//MATCH GCN
 s32 NuSpecialFind(struct nugscn_s *scene,struct nuhspecial_s *special,char *name) {
   s32 i;
   struct nuspecial_s *spec;
 
+  if (scene->specialix != NULL) {
+    i = NuNameIxFind(scene->specialix,name);
+    if (i == -1) {
+      return 0;
+    }
+    special->scene = scene;
+    special->special = &scene->specials[i];
+    return 1;
+  }
   spec = scene->specials;
     for (i = 0; i < scene->numspecial; i++) {
       if (strcasecmp(name,spec->name) == 0) {
@@ -101,32 +113,97 @@ s32 NuRndrGScnObj(struct nugobj_s *gobj,struct numtx_s *wm) {
   return NuRndrGobj(gobj,wm,NULL);
 }
 
-static s32* ps2_scratch_free;	// --> point to PS2_SCRATCH_BASE
-unsigned char PS2_SCRATCH_BASE[16384];
+// Size: 0x18
+struct nuscratch_s
+{
+    u8* base;
+    u8* start;
+    u8* top;
+    u8* end;
+    s32 highwater;
+    s32 depth;
+};
+
+#define NUSCRATCH_ALIGN(n) (((uintptr_t)(n) + 15) & ~(uintptr_t)15)
+
+s32 NuScratchSize = 16384;
+static NUTHREADLOCAL struct nuscratch_s scratch;
+
+static void NuScratchInit(void) {
+    scratch.base = (u8 *)malloc(NuScratchSize + 16);
+    if (scratch.base == NULL) {
+        NuErrorProlog("OpenCrashWOC/code/nuxbox/dummyfunc.c",__LINE__)("NuScratchAlloc32 : unable to allocate %d bytes",NuScratchSize);
+    }
+    scratch.start = (u8 *)NUSCRATCH_ALIGN(scratch.base);
+    scratch.top = scratch.start;
+    scratch.end = scratch.start + NuScratchSize;
+    scratch.highwater = 0;
+    scratch.depth = 0;
+}
 
-//MATCH NGC
+// Each block is followed by the previous top so blocks can be popped one at a time.
 void* NuScratchAlloc32(s32 size) {
-s32 old;
-s32 sizeAligned;
-s32 addrAligned;
-
-    old = ps2_scratch_free;
-    sizeAligned = ALIGN4(size);
-    addrAligned = ALIGN4(ps2_scratch_free);
-
-    ps2_scratch_free = addrAligned + sizeAligned;
-    *(s32 *)(addrAligned + sizeAligned) = old;
-    ps2_scratch_free += 4;
-    return (void *)addrAligned;
+    u8* old;
+    u8* block;
+    u8* top;
+
+    if (scratch.base == NULL) {
+        NuScratchInit();
+    }
+    old = scratch.top;
+    block = (u8 *)NUSCRATCH_ALIGN(old);
+    top = block + NUSCRATCH_ALIGN(size) + sizeof(u8*);
+    if (top > scratch.end) {
+        NuErrorProlog("OpenCrashWOC/code/nuxbox/dummyfunc.c",__LINE__)
+            ("NuScratchAlloc32 : overflow allocating %d bytes, %d of %d used",size,(s32)(old - scratch.start),(s32)(scratch.end - scratch.start));
+        return NULL;
+    }
+    *(u8 **)(top - sizeof(u8*)) = old;
+    scratch.top = top;
+    scratch.depth++;
+    if ((s32)(top - scratch.start) > scratch.highwater) {
+        scratch.highwater = (s32)(top - scratch.start);
+    }
+    return block;
 }
 
-//MATCH NGC
 void NuScratchRelease(void) {
-  ps2_scratch_free = ps2_scratch_free[-1];
-  return;
+    if (scratch.depth <= 0) {
+        NuErrorProlog("OpenCrashWOC/code/nuxbox/dummyfunc.c",__LINE__)("NuScratchRelease : nothing to release");
+        return;
+    }
+    scratch.top = *(u8 **)(scratch.top - sizeof(u8*));
+    scratch.depth--;
 }
 
+void* NuScratchMark(void) {
+    if (scratch.base == NULL) {
+        NuScratchInit();
+    }
+    return scratch.top;
+}
+
+void NuScratchReleaseTo(void* mark) {
+    while (scratch.top > (u8 *)mark) {
+        NuScratchRelease();
+    }
+    if (scratch.top != (u8 *)mark) {
+        NuErrorProlog("OpenCrashWOC/code/nuxbox/dummyfunc.c",__LINE__)("NuScratchReleaseTo : bad mark");
+    }
+}
+
+s32 NuScratchHighWater(void) {
+    return scratch.highwater;
+}
 
+void NuScratchReport(char* title) {
+    printf("NuScratch %s: %d / %d bytes high water, %d blocks live\n",title,scratch.highwater,(s32)(scratch.end - scratch.start),scratch.depth);
+}
+
+void NuScratchThreadClose(void) {
+    free(scratch.base);
+    memset(&scratch,0,sizeof(struct nuscratch_s));
+}
 
 //NGC MATCH
 float ** NuHGobjEvalDwa(int layer,void *bollox,struct nuanimdata_s *vtxanim,float vtxtime) {
@@ -863,79 +940,105 @@ void NuPs2Init(void)
   return;
 }
 
-//NGC MATCH
-void NuGScnUpdate(struct nugscn_s *scn, float dt) {
-    s32 cnt;
-    struct nuinstance_s * i;
+// Instances handed to each worker by NuGScnUpdate.
+#define GSCNUPDATE_CHUNK 32
+
+struct gscnupdate_s {
+    struct nugscn_s *scn;
+    float dt;
+};
+
+// Steps one instance's animation and rebuilds its matrix, touching nothing but the instance's own nuinstanim_s.
+static void NuGScnUpdateInstance(struct nugscn_s *scn, struct nuinstance_s *i, float dt) {
     struct nuinstanim_s * instanim;
     struct nuanimdata_s * animdata;
     struct nuanimtime_s atime;
-    struct nuanimdatachunk_s * chunk;
     struct numtx_s animtx;
+    struct nuvec_s t;
     float ltime;
 
-    cnt = scn->numinstance;
-    i = &scn->instances[cnt];
-    while ( cnt != 0 ) {
-        i--;
-        cnt--;
-        if (((i->flags.visible) & i->flags.visitest) < 0) { 
-            instanim = i->anim;
-            if (i->anim != NULL) {
-                 if (scn->instanimdata != NULL) {
-                    if (scn->instanimdata[i->anim->anim_ix] != NULL) {
-
-                        
-                        animdata = scn->instanimdata[i->anim->anim_ix];
-                        if (instanim->playing) {
-                            instanim->ltime += dt * instanim->tfactor;
-                            if ((instanim->waiting) && (instanim->ltime >= instanim->tfirst)) {
-                                instanim->waiting = 0; 
-                                instanim->ltime -=  instanim->tfirst - 1.0f;
-                            }
-                            
-                            if (instanim->waiting == 0) {
-                                if (instanim->ltime >= (animdata->time + instanim->tinterval)) {
-                                    if (instanim->repeating != 0) {
-                                        for ( ; instanim->ltime >= (animdata->time + instanim->tinterval); ) {
-                                            if (instanim->oscillate != 0) {
-                                                instanim->backwards = !instanim->backwards;
-                                            }
-                                            instanim->ltime = (instanim->ltime + 1.0f) - (animdata->time + instanim->tinterval);
-                                        } 
-                                        ltime = instanim->ltime;
-                                    }
-                                    else {
-                                        instanim->playing = 0;
-                                        ltime = instanim->ltime = animdata->time;
-                                    }
-                                }
-                                else if (instanim->ltime > animdata->time) {
-                                    ltime = animdata->time;
-                                }
-                                else {
-                                    ltime = instanim->ltime;
-                                }
-                                
-                                if (instanim->backwards != 0) {
-                                    ltime = (animdata->time + 1.0f) - ltime;
-                                }
-                            }
-                        }
-                        else {
-                            ltime = instanim->ltime;
+    instanim = i->anim;
+    animdata = scn->instanimdata[instanim->anim_ix];
+    if (instanim->playing) {
+        instanim->ltime += dt * instanim->tfactor;
+        if ((instanim->waiting) && (instanim->ltime >= instanim->tfirst)) {
+            instanim->waiting = 0; 
+            instanim->ltime -=  instanim->tfirst - 1.0f;
+        }
+        
+        if (instanim->waiting == 0) {
+            if (instanim->ltime >= (animdata->time + instanim->tinterval)) {
+                if (instanim->repeating != 0) {
+                    for ( ; instanim->ltime >= (animdata->time + instanim->tinterval); ) {
+                        if (instanim->oscillate != 0) {
+                            instanim->backwards = !instanim->backwards;
                         }
-                        NuAnimDataCalcTime(animdata, ltime, &atime);
-                        NuAnimCurveSetApplyToMatrix(*animdata->chunks[atime.chunk]->animcurvesets, &atime, &animtx);
-                        memcpy(&instanim->mtx, &animtx, sizeof(struct numtx_s));
-                        NuMtxTranslate(&instanim->mtx, (struct nuvec_s*)&i->mtx._30);
-                    }
+                        instanim->ltime = (instanim->ltime + 1.0f) - (animdata->time + instanim->tinterval);
+                    } 
+                    ltime = instanim->ltime;
+                }
+                else {
+                    instanim->playing = 0;
+                    ltime = instanim->ltime = animdata->time;
                 }
             }
+            else if (instanim->ltime > animdata->time) {
+                ltime = animdata->time;
+            }
+            else {
+                ltime = instanim->ltime;
+            }
+            
+            if (instanim->backwards != 0) {
+                ltime = (animdata->time + 1.0f) - ltime;
+            }
+        }
+    }
+    else {
+        ltime = instanim->ltime;
+    }
+    NuAnimDataCalcTime(animdata, ltime, &atime);
+
+    // paused or not advanced: only the translation can have moved, with the instance
+    if ((instanim->evalvalid) && (instanim->evaltime == ltime)) {
+        NuAnimCurveSetCalcTranslation(*animdata->chunks[atime.chunk]->animcurvesets, &atime, &t);
+        instanim->mtx._30 = t.x + i->mtx._30;
+        instanim->mtx._31 = t.y + i->mtx._31;
+        instanim->mtx._32 = t.z + i->mtx._32;
+        return;
+    }
+
+    NuAnimCurveSetApplyToMatrix(*animdata->chunks[atime.chunk]->animcurvesets, &atime, &animtx);
+    memcpy(&instanim->mtx, &animtx, sizeof(struct numtx_s));
+    NuMtxTranslate(&instanim->mtx, (struct nuvec_s*)&i->mtx._30);
+    instanim->evaltime = ltime;
+    instanim->evalvalid = 1;
+}
+
+static void NuGScnUpdateRange(void *data, s32 start, s32 end) {
+    struct gscnupdate_s *update;
+    struct nuinstance_s *i;
+
+    update = (struct gscnupdate_s *)data;
+    for (i = &update->scn->instances[start]; i < &update->scn->instances[end]; i++) {
+        if ((((i->flags.visible) & i->flags.visitest) < 0) && (i->anim != NULL)
+            && (update->scn->instanimdata[i->anim->anim_ix] != NULL)) {
+            NuGScnUpdateInstance(update->scn, i, update->dt);
         }
     }
 }
 
+void NuGScnUpdate(struct nugscn_s *scn, float dt) {
+    struct gscnupdate_s update;
+
+    if (scn->instanimdata == NULL) {
+        return;
+    }
+    update.scn = scn;
+    update.dt = dt;
+    NuJobParallelFor(NuGScnUpdateRange, &update, scn->numinstance, GSCNUPDATE_CHUNK);
+}
+
 struct _LARGE_INTEGER_NGC timerfreq;
 struct _LARGE_INTEGER_NGC timer_start;
 s32 frame_counter;
@@ -976,24 +1079,15 @@ s32 NuGetFrameAdvance(void) {
 }
 
 
-s32 s_223;
-s32 t_224;
-s32 u_225;
-
-//NGC MATCH
+// Both used to go through rand(), which takes a lock in some C libraries. randy keeps its 31 bit range.
 s32 randy(void)
 {
-  s_223 = s_223 + 1;
-  s_223 = rand();
-  u_225 = rand();
-  t_224 = (s_223 & 0x7fff) << 0x10 | u_225 & 0xffff;
-  return t_224;
+  return NuRngU32(NuRngStream(NURNG_GAME)) >> 1;
 }
 
-//NGC MATCH
 float randyfloat(void)
 {
-  return rand() * 4.656613f; //4.6566129E-10
+  return NuRngFloat(NuRngStream(NURNG_GAME));
 }
 
 //NGC MATCH
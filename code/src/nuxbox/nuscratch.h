@@ -0,0 +1,42 @@
+#ifndef NUSCRATCH_H
+#define NUSCRATCH_H
+
+#include "../types.h"
+
+/*
+  Per thread scratch stacks. NuScratchAlloc32 pushes a block and NuScratchRelease pops the last one,
+  or take a NuScratchMark before a run of allocations and hand it to NuScratchReleaseTo afterwards.
+  Each thread gets its own stack the first time it allocates, NuScratchSize bytes big.
+*/
+
+#if defined(_MSC_VER)
+#define NUTHREADLOCAL __declspec(thread)
+#else
+#define NUTHREADLOCAL __thread
+#endif
+
+// Bytes given to each new thread's stack, change before the thread first allocates.
+extern s32 NuScratchSize;
+
+// Allocate size bytes (16 byte aligned) from this thread's stack.
+void* NuScratchAlloc32(s32 size);
+
+// Free the last block allocated.
+void NuScratchRelease(void);
+
+// Current top of this thread's stack.
+void* NuScratchMark(void);
+
+// Free everything allocated since mark was taken.
+void NuScratchReleaseTo(void* mark);
+
+// Most bytes this thread's stack has held at once.
+s32 NuScratchHighWater(void);
+
+// Print this thread's stack usage.
+void NuScratchReport(char* title);
+
+// Free this thread's stack, call before a worker thread exits.
+void NuScratchThreadClose(void);
+
+#endif // !NUSCRATCH_H
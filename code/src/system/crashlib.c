@@ -52,7 +52,6 @@ struct D3DTexture* NudxTx_Create(struct nutex_s* texture, s32 rendertargetflag)
     unsigned char* inbits24;
     unsigned short* inbits16;
     long* inbits32;
-    long* outbits;
     long* outline;
     unsigned short* outline16;
     unsigned char* inbits8;
@@ -224,13 +223,13 @@ struct D3DTexture* NudxTx_Create(struct nutex_s* texture, s32 rendertargetflag)
                     // uVar6 = (u32)bits[s];
                     if (type == NUTEX_PAL4) {
                         if ((s & 1) != 0) {
-                            mapix = bits[s / 2] >> 4;
+                            mapix = inbits8[s / 2] >> 4;
                         }
                         else {
-                            mapix = bits[s / 2] & 0xf;
+                            mapix = inbits8[s / 2] & 0xf;
                         }
                     } else if (type == NUTEX_PAL8) {
-                        mapix = bits[s];
+                        mapix = inbits8[s];
                     }
                     
                     *(u32*)b1 = pal[mapix];
@@ -265,8 +264,9 @@ struct D3DTexture* NudxTx_Create(struct nutex_s* texture, s32 rendertargetflag)
             texture->decal = 0;
     } 
     
-    GS_TexCreateNU(type, texture->width, texture->height, &outbits, texture->mmcnt, rendertargetflag, GetTPID());
-    free_x(&outbits);
+    // the converted image is in bits, the source was kept in inbits*
+    GS_TexCreateNU(type, texture->width, texture->height, bits, texture->mmcnt, rendertargetflag, GetTPID());
+    free_x(bits);
     DebugText[0] = '\0';
     return NULL;
 }
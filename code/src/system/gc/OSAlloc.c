@@ -1,202 +1,154 @@
 #include "OSAlloc.h"
+#include <stdint.h>
 
 
 #define InRange(addr, start, end)                                             \
     ((u8*) (start) <= (u8*) (addr) && (u8*) (addr) < (u8*) (end))
 #define OFFSET(addr, align) (((uintptr_t) (addr) & ((align) -1)))
-#define OSRoundUp32B(x) (((u32) (x) + 32 - 1) & ~(32 - 1))
+#define OSRoundUp32B(x) (((uintptr_t) (x) + 32 - 1) & ~(32 - 1))
+#define OSRoundDown32B(x) (((uintptr_t) (x)) & ~(32 - 1))
 
 #define ALIGNMENT 32
 #define MINOBJSIZE 64
 
-void unlink_node(struct Heap *heap, struct ListNode *node)
+// Sizes are multiples of 32 so the low bits of HeapCell.size are free for flags.
+#define CELL_FREE 1
+#define CELL_PREVFREE 2
+#define CELL_SIZE(cell) ((cell)->size & ~(ALIGNMENT - 1))
+#define CELL_NEXT(cell) ((HeapCell*) ((u8*) (cell) + CELL_SIZE(cell)))
+#define SMALLBLOCK (1 << (OSALLOC_SL_LOG2 + 5))
+
+#ifdef OSALLOC_DEBUG
+#define GUARDSIZE ALIGNMENT
+#define GUARDBYTE 0xfd
+#else
+#define GUARDSIZE 0
+#endif
+
+static s32 NumHeaps;
+static void* ArenaStart;
+static void* ArenaEnd;
+
+// Index of the highest set bit, -1 for 0.
+static s32 fls32(u32 x)
 {
-    struct ListNode *head = heap->free;
-
-        if (node->next != NULL)
-            node->next->prev = node->prev;
-
-        if (node->prev == NULL)
-            head = node->next;
-        else
-            node->prev->next = node->next;
-        heap->free = head;
+    s32 bit = 31;
+
+    if (x == 0)
+        return -1;
+    if ((x & 0xffff0000) == 0) { x <<= 16; bit -= 16; }
+    if ((x & 0xff000000) == 0) { x <<= 8; bit -= 8; }
+    if ((x & 0xf0000000) == 0) { x <<= 4; bit -= 4; }
+    if ((x & 0xc0000000) == 0) { x <<= 2; bit -= 2; }
+    if ((x & 0x80000000) == 0) { bit -= 1; }
+    return bit;
 }
 
-void *OSAllocFromHeap(s32 handle, u32 size)
+static s32 ffs32(u32 x)
 {
-    struct Heap *heap = &HeapArray[handle];
-    s32 sizeAligned = OSRoundUp32B(32 + size);
-    struct ListNode *node;
-    struct ListNode *oldTail;
-    u32 leftoverSpace;
-
-    // find first node with enough capacity
-    for (node = heap->free; node != NULL; node = node->next)
-    {
-        if (sizeAligned <= node->size)
-            break;
-    }
-    if (node == NULL)
-        return NULL;
+    return fls32(x & (~x + 1));
+}
 
-    leftoverSpace = node->size - sizeAligned;
-    if (leftoverSpace < 64)
-    {
-        // remove this node from list
-        unlink_node(heap, node);
-    }
-    else
-    {
-        // make a new node out of the remaining space and remove the current node
-        struct ListNode *newNode;
-        newNode = (void *)((u8 *)node + sizeAligned);
-        node->size = sizeAligned;
-        newNode->size = leftoverSpace;
-        newNode->prev = node->prev;
-        newNode->next = node->next;
-        if (newNode->next != NULL)
-            newNode->next->prev = newNode;
-        if (newNode->prev != NULL)
-            newNode->prev->next = newNode;
-        else
-            heap->free = newNode;
-    }
-    // add this node to the end?
-    oldTail = heap->allocated;
-    node->next = oldTail;
-    node->prev = NULL;
-    if (oldTail != NULL)
-        oldTail->prev = node;
-    heap->allocated = node;
-    return (u8 *)node + 32;
-}
-
-/*
-size_t OSCheckHeap(s32 heap)
+static void mapping_insert(u32 size, s32* fl, s32* sl)
 {
-    Heap* hd;
-    HeapCell* cell;
-    int total = 0;
-    int totalFree = 0;
+    s32 f;
 
-#define CHECK(line, condition)                                                \
-    if (!(condition)) {                                                       \
-        OSReport("OSCheckHeap: Failed " #condition " in %d", line);           \
-        return -1;                                                            \
+    if (size < SMALLBLOCK) {
+        *fl = 0;
+        *sl = size >> 5;
     }
-
-    CHECK(893, HeapArray)
-    CHECK(894, 0 <= heap && heap < NumHeaps)
-    hd = &HeapArray[heap];
-    CHECK(897, 0 <= hd->size)
-    CHECK(899, hd->allocated == NULL || hd->allocated->prev == NULL)
-
-    for (cell = hd->allocated; cell != NULL; cell = cell->next) {
-        CHECK(902, InRange(cell, ArenaStart, ArenaEnd))
-        CHECK(903, OFFSET(cell, ALIGNMENT) == 0)
-        CHECK(904, cell->next == NULL || cell->next->prev == cell)
-        CHECK(905, MINOBJSIZE <= cell->size)
-        CHECK(906, OFFSET(cell->size, ALIGNMENT) == 0)
-        total += cell->size;
-        CHECK(909, 0 < total && total <= hd->size)
+    else {
+        f = fls32(size);
+        *sl = (size >> (f - OSALLOC_SL_LOG2)) ^ OSALLOC_SL_COUNT;
+        *fl = f - (OSALLOC_SL_LOG2 + 5) + 1;
     }
+}
 
-    CHECK(917, hd->free == NULL || hd->free->prev == NULL)
-    for (cell = hd->free; cell != NULL; cell = cell->next) {
-        CHECK(920, InRange(cell, ArenaStart, ArenaEnd))
-        CHECK(921, OFFSET(cell, ALIGNMENT) == 0)
-        CHECK(922, cell->next == NULL || cell->next->prev == cell)
-        CHECK(923, MINOBJSIZE <= cell->size)
-        CHECK(924, OFFSET(cell->size, ALIGNMENT) == 0)
-        CHECK(925, cell->next == NULL ||
-                       (char*) cell + cell->size < (char*) cell->next)
-        total += cell->size;
-        totalFree += cell->size - 32;
-        CHECK(929, 0 < total && total <= hd->size)
+// Round the request up to the next class so any block in the list found is big enough.
+static void mapping_search(u32 size, s32* fl, s32* sl)
+{
+    if (size >= SMALLBLOCK) {
+        size += (1 << (fls32(size) - OSALLOC_SL_LOG2)) - 1;
     }
-
-    CHECK(936, total == hd->size);
-
-#undef CHECK
-
-    return totalFree;
+    mapping_insert(size, fl, sl);
 }
 
-
-
-void OSFreeToHeap(s32 heap, any_t ptr)
+static void remove_free(struct Heap* heap, HeapCell* cell)
 {
-    HeapCell* cell = (any_t) ((u8*) ptr - ALIGNMENT);
-    Heap* hd = &HeapArray[heap];
-    HeapCell* list = hd->allocated;
+    s32 fl;
+    s32 sl;
 
-    // remove cell from the allocated list
-    // hd->allocated = DLExtract(hd->allocated, cell);
-    if (cell->next != NULL) {
+    mapping_insert(CELL_SIZE(cell), &fl, &sl);
+    if (cell->next != NULL)
         cell->next->prev = cell->prev;
-    }
-    if (cell->prev == NULL) {
-        list = cell->next;
-    } else {
+    if (cell->prev != NULL)
         cell->prev->next = cell->next;
+    else {
+        heap->blocks[fl][sl] = cell->next;
+        if (cell->next == NULL) {
+            heap->slbitmap[fl] &= ~(1u << sl);
+            if (heap->slbitmap[fl] == 0)
+                heap->flbitmap &= ~(1u << fl);
+        }
     }
+    heap->freebytes -= CELL_SIZE(cell);
+}
 
-    hd->allocated = list;
-    hd->free = DLInsert(hd->free, cell); //hd->free = DLInsert(hd->free, cell, list);
+static void insert_free(struct Heap* heap, HeapCell* cell)
+{
+    s32 fl;
+    s32 sl;
+
+    mapping_insert(CELL_SIZE(cell), &fl, &sl);
+    cell->prev = NULL;
+    cell->next = heap->blocks[fl][sl];
+    if (cell->next != NULL)
+        cell->next->prev = cell;
+    heap->blocks[fl][sl] = cell;
+    heap->slbitmap[fl] |= 1u << sl;
+    heap->flbitmap |= 1u << fl;
+    heap->freebytes += CELL_SIZE(cell);
 }
 
-static HeapCell* DLInsert(HeapCell* list, HeapCell* cell)
+static HeapCell* find_free(struct Heap* heap, u32 size)
 {
-    HeapCell* before = NULL;
-    HeapCell* after = list;
+    s32 fl;
+    s32 sl;
+    u32 map;
 
-    while (after != NULL) {
-        if (cell <= after) {
-            break;
-        }
-        before = after;
-        after = after->next;
-    }
-    cell->next = after;
-    cell->prev = before;
-    if (after != NULL) {
-        after->prev = cell;
-        if ((u8*) cell + cell->size == (u8*) after) {
-            cell->size += after->size;
-            after = after->next;
-            cell->next = after;
-            if (after != NULL) {
-                after->prev = cell;
-            }
-        }
-    }
-    if (before != NULL) {
-        before->next = cell;
-        if ((u8*) before + before->size == (u8*) cell) {
-            before->size += cell->size;
-            before->next = after;
-            if (after != NULL) {
-                after->prev = before;
-            }
-        }
-        return list;
+    mapping_search(size, &fl, &sl);
+    if (fl >= OSALLOC_FL_COUNT)
+        return NULL;
+    map = heap->slbitmap[fl] & (~0u << sl);
+    if (map == 0) {
+        map = (fl + 1 < OSALLOC_FL_COUNT) ? (heap->flbitmap & (~0u << (fl + 1))) : 0;
+        if (map == 0)
+            return NULL;
+        fl = ffs32(map);
+        map = heap->slbitmap[fl];
     }
-    return cell;
-} */
+    sl = ffs32(map);
+    return heap->blocks[fl][sl];
+}
 
-s32 OSSetCurrentHeap(s32 heap)
+#ifdef OSALLOC_DEBUG
+static s32 guard_ok(HeapCell* cell)
 {
-    s32 old = __OSCurrHeap;
+    u8* p = (u8*) cell + ALIGNMENT + cell->request;
+    u8* end = (u8*) cell + CELL_SIZE(cell);
 
-    __OSCurrHeap = heap;
-    return old;
+    for (; p < end; p++) {
+        if (*p != GUARDBYTE)
+            return 0;
+    }
+    return 1;
 }
-/*
-any_t OSInitAlloc(any_t arenaStart, any_t arenaEnd, int maxHeaps)
+#endif
+
+void* OSInitAlloc(void* arenaStart, void* arenaEnd, s32 maxHeaps)
 {
     u32 totalSize = maxHeaps * sizeof(Heap);
-    int i;
+    s32 i;
 
     HeapArray = arenaStart;
     NumHeaps = maxHeaps;
@@ -205,45 +157,227 @@ any_t OSInitAlloc(any_t arenaStart, any_t arenaEnd, int maxHeaps)
         Heap* heap = &HeapArray[i];
 
         heap->size = -1;
-        heap->free = heap->allocated = NULL;
+        heap->first = NULL;
     }
 
     __OSCurrHeap = -1;
 
     arenaStart = (u8*) HeapArray + totalSize;
-    arenaStart = (any_t) OSRoundUp32B(arenaStart);
+    arenaStart = (void*) OSRoundUp32B(arenaStart);
 
     ArenaStart = arenaStart;
-    ArenaEnd = (any_t) OSRoundDown32B(arenaEnd);
+    ArenaEnd = (void*) OSRoundDown32B(arenaEnd);
 
     return arenaStart;
 }
 
-s32 OSCreateHeap(any_t start, any_t end)
+s32 OSCreateHeap(void* start, void* end)
 {
-    int i;
-    HeapCell* cell = (any_t) OSRoundUp32B(start);
+    s32 i;
+    HeapCell* cell = (void*) OSRoundUp32B(start);
+    HeapCell* sentinel;
 
-    end = (any_t) OSRoundDown32B(end);
+    end = (void*) OSRoundDown32B(end);
     for (i = 0; i < NumHeaps; i++) {
         Heap* hd = &HeapArray[i];
 
         if (hd->size < 0) {
+            memset(hd, 0, sizeof(Heap));
             hd->size = (u8*) end - (u8*) cell;
-            cell->prev = NULL;
-            cell->next = NULL;
-            cell->size = hd->size;
-            hd->free = cell;
-            hd->allocated = NULL;
+            hd->first = cell;
+            // Zero sized used block at the end so merging never walks off the heap.
+            sentinel = (HeapCell*) ((u8*) end - ALIGNMENT);
+            cell->size = ((u8*) sentinel - (u8*) cell) | CELL_FREE;
+            cell->prevphys = NULL;
+            sentinel->size = CELL_PREVFREE;
+            sentinel->prevphys = cell;
+            insert_free(hd, cell);
             return i;
         }
     }
     return -1;
 }
 
-void OSDestroyHeap(size_t idx)
+void OSDestroyHeap(s32 idx)
+{
+    HeapArray[idx].size = -1;
+}
+
+s32 OSSetCurrentHeap(s32 heap)
+{
+    s32 old = __OSCurrHeap;
+
+    __OSCurrHeap = heap;
+    return old;
+}
+
+void *OSAllocFromHeap(s32 handle, u32 size)
 {
-    *(s32*) &HeapArray[idx] = -1;
+    struct Heap *heap = &HeapArray[handle];
+    u32 sizeAligned = OSRoundUp32B(ALIGNMENT + size + GUARDSIZE);
+    HeapCell* cell;
+    HeapCell* rest;
+    u32 leftoverSpace;
+
+    if (sizeAligned < MINOBJSIZE)
+        sizeAligned = MINOBJSIZE;
+    cell = find_free(heap, sizeAligned);
+    if (cell == NULL)
+        return NULL;
+    remove_free(heap, cell);
+
+    leftoverSpace = CELL_SIZE(cell) - sizeAligned;
+    if (leftoverSpace >= MINOBJSIZE) {
+        // Split, the remainder goes back on a free list.
+        rest = (HeapCell*) ((u8*) cell + sizeAligned);
+        rest->size = leftoverSpace | CELL_FREE;
+        rest->prevphys = cell;
+        CELL_NEXT(rest)->prevphys = rest;
+        insert_free(heap, rest);
+        cell->size = sizeAligned | (cell->size & CELL_PREVFREE);
+    }
+    else {
+        cell->size &= ~CELL_FREE;
+        CELL_NEXT(cell)->size &= ~CELL_PREVFREE;
+    }
+    cell->request = size;
+#ifdef OSALLOC_DEBUG
+    memset((u8*) cell + ALIGNMENT + size, GUARDBYTE, CELL_SIZE(cell) - ALIGNMENT - size);
+#endif
+
+    heap->used += CELL_SIZE(cell);
+    if (heap->used > heap->peak)
+        heap->peak = heap->used;
+    heap->allocs++;
+    return (u8 *)cell + ALIGNMENT;
 }
 
-*/
+void OSFreeToHeap(s32 handle, void* ptr)
+{
+    struct Heap *heap = &HeapArray[handle];
+    HeapCell* cell = (HeapCell*) ((u8*) ptr - ALIGNMENT);
+    HeapCell* next;
+    HeapCell* prev;
+
+#ifdef OSALLOC_DEBUG
+    if (guard_ok(cell) == 0)
+        printf("OSFreeToHeap: guard bytes overwritten after %p (%d bytes)\n", ptr, cell->request);
+#endif
+    heap->used -= CELL_SIZE(cell);
+    heap->allocs--;
+    cell->size |= CELL_FREE;
+
+    // Merge with the free neighbours either side.
+    next = CELL_NEXT(cell);
+    if (next->size & CELL_FREE) {
+        remove_free(heap, next);
+        cell->size += CELL_SIZE(next);
+        next = CELL_NEXT(cell);
+        next->prevphys = cell;
+    }
+    if (cell->size & CELL_PREVFREE) {
+        prev = cell->prevphys;
+        remove_free(heap, prev);
+        prev->size += CELL_SIZE(cell);
+        cell = prev;
+        next->prevphys = cell;
+    }
+    next->size |= CELL_PREVFREE;
+    insert_free(heap, cell);
+}
+
+u32 OSReferentSize(void* ptr)
+{
+    HeapCell* cell = (HeapCell*) ((u8*) ptr - ALIGNMENT);
+
+    return CELL_SIZE(cell) - ALIGNMENT;
+}
+
+// Walk every block in address order and check the links, flags and free lists agree.
+// Returns the free bytes (less headers) like the SDK version, or -1 if the heap is damaged.
+s32 OSCheckHeap(s32 handle)
+{
+    Heap* hd;
+    HeapCell* cell;
+    HeapCell* prev = NULL;
+    s32 fl;
+    s32 sl;
+    u32 total = 0;
+    u32 totalFree = 0;
+    u32 listFree = 0;
+    s32 prevFree = 0;
+
+#define CHECK(line, condition)                                                \
+    if (!(condition)) {                                                       \
+        printf("OSCheckHeap: Failed " #condition " in %d\n", line);           \
+        return -1;                                                            \
+    }
+
+    CHECK(__LINE__, HeapArray)
+    CHECK(__LINE__, 0 <= handle && handle < NumHeaps)
+    hd = &HeapArray[handle];
+    CHECK(__LINE__, 0 <= hd->size)
+
+    for (cell = hd->first; CELL_SIZE(cell) != 0; cell = CELL_NEXT(cell)) {
+        CHECK(__LINE__, InRange(cell, hd->first, (u8*) hd->first + hd->size))
+        CHECK(__LINE__, OFFSET(cell, ALIGNMENT) == 0)
+        CHECK(__LINE__, MINOBJSIZE <= CELL_SIZE(cell))
+        CHECK(__LINE__, cell->prevphys == prev)
+        CHECK(__LINE__, ((cell->size & CELL_PREVFREE) != 0) == prevFree)
+        prevFree = (cell->size & CELL_FREE) != 0;
+        // Free blocks are always merged so two never sit side by side.
+        CHECK(__LINE__, !(prevFree && (cell->size & CELL_PREVFREE)))
+        if (prevFree) {
+            totalFree += CELL_SIZE(cell) - ALIGNMENT;
+        }
+#ifdef OSALLOC_DEBUG
+        else {
+            CHECK(__LINE__, guard_ok(cell))
+        }
+#endif
+        total += CELL_SIZE(cell);
+        CHECK(__LINE__, 0 < total && total <= (u32) hd->size)
+        prev = cell;
+    }
+    CHECK(__LINE__, total + ALIGNMENT == (u32) hd->size)
+
+    for (fl = 0; fl < OSALLOC_FL_COUNT; fl++) {
+        for (sl = 0; sl < OSALLOC_SL_COUNT; sl++) {
+            CHECK(__LINE__, ((hd->slbitmap[fl] >> sl) & 1) == (hd->blocks[fl][sl] != NULL))
+            for (cell = hd->blocks[fl][sl]; cell != NULL; cell = cell->next) {
+                CHECK(__LINE__, cell->size & CELL_FREE)
+                CHECK(__LINE__, cell->next == NULL || cell->next->prev == cell)
+                listFree += CELL_SIZE(cell) - ALIGNMENT;
+            }
+        }
+        CHECK(__LINE__, ((hd->flbitmap >> fl) & 1) == (hd->slbitmap[fl] != 0))
+    }
+    CHECK(__LINE__, listFree == totalFree)
+
+#undef CHECK
+
+    return totalFree;
+}
+
+void OSGetHeapStats(s32 handle, OSHeapStats* stats)
+{
+    Heap* hd = &HeapArray[handle];
+    HeapCell* cell;
+    u32 largest = 0;
+    s32 fl;
+    s32 sl;
+
+    // The largest block is in the highest non empty list.
+    if (hd->flbitmap != 0) {
+        fl = fls32(hd->flbitmap);
+        sl = fls32(hd->slbitmap[fl]);
+        for (cell = hd->blocks[fl][sl]; cell != NULL; cell = cell->next) {
+            if (CELL_SIZE(cell) > largest)
+                largest = CELL_SIZE(cell);
+        }
+    }
+    stats->used = hd->used;
+    stats->peak = hd->peak;
+    stats->largestfree = (largest > ALIGNMENT + GUARDSIZE) ? largest - ALIGNMENT - GUARDSIZE : 0;
+    stats->fragmentation = (hd->freebytes != 0) ? (1.0f - (f32) largest / (f32) hd->freebytes) : 0.0f;
+}
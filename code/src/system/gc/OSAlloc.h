@@ -3,24 +3,55 @@
 #include "system/gxtype.h"
 #include "system/gc/GXBump.h"
 
+// Define to pad every allocation with guard bytes that OSFreeToHeap and OSCheckHeap verify.
+//#define OSALLOC_DEBUG
+
+// Two level segregated fit: the first level splits sizes by power of two, the second splits
+// each power of two into 16 linear classes. Sizes under 512 bytes all live in first level 0.
+#define OSALLOC_SL_LOG2 4
+#define OSALLOC_SL_COUNT (1 << OSALLOC_SL_LOG2)
+#define OSALLOC_FL_COUNT 24
+
 s32 __OSCurrHeap;
 static struct Heap* HeapArray;
 
-typedef struct ListNode
-{
-    struct ListNode *prev;
-    struct ListNode *next;
-    s32 size;
-};
-
+// Block header. Each block sets aside ALIGNMENT (32) bytes in front of the user memory for it so that stays 32 byte
+// aligned, the struct itself is smaller.
+// Size: 0x14
 typedef struct HeapCell {
+	u32 size;                   // whole block including this header, low bits are flags
+	u32 request;                // size asked for, used by the guard bytes
+	struct HeapCell* prevphys;  // block just before this one in memory
+	struct HeapCell* next;      // free list links, only valid while the block is free
 	struct HeapCell* prev;
-	struct HeapCell* next;
-	u32 size;
 } HeapCell;
 
 typedef struct Heap {
 	s32 size;
-	struct HeapCell* free;      // linked list of free cells
-	struct HeapCell* allocated; // linked list of allocated cells
+	struct HeapCell* first;     // first block, the heap ends with a zero sized sentinel
+	u32 flbitmap;
+	u32 slbitmap[OSALLOC_FL_COUNT];
+	struct HeapCell* blocks[OSALLOC_FL_COUNT][OSALLOC_SL_COUNT];
+	u32 used;
+	u32 peak;
+	u32 freebytes;
+	u32 allocs;
 } Heap;
+
+// Size: 0x10
+typedef struct OSHeapStats {
+	u32 used;                   // bytes in allocated blocks, headers included
+	u32 peak;                   // highest value of used since the heap was created
+	u32 largestfree;            // biggest single allocation that would still succeed
+	f32 fragmentation;          // 1 - largestfree / free bytes, 0 when free space is one block
+} OSHeapStats;
+
+void* OSInitAlloc(void* arenaStart, void* arenaEnd, s32 maxHeaps);
+s32 OSCreateHeap(void* start, void* end);
+void OSDestroyHeap(s32 heap);
+s32 OSSetCurrentHeap(s32 heap);
+void* OSAllocFromHeap(s32 handle, u32 size);
+void OSFreeToHeap(s32 handle, void* ptr);
+s32 OSCheckHeap(s32 handle);
+u32 OSReferentSize(void* ptr);
+void OSGetHeapStats(s32 handle, OSHeapStats* stats);
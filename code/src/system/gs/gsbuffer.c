@@ -1,10 +1,13 @@
 #include "gsbuffer.h"
 
-//MATCH GCN
+// NULL if the heap is out.
 void* GS_CreateBuffer (u32 length, s32 btype){
     struct _GS_BUFFER *bufptr;
 
     bufptr = (struct _GS_BUFFER*)malloc(length + 8);
+    if (bufptr == NULL) {
+        return NULL;
+    }
     GS_BufferSize += length;
     bufptr->length = length;
     bufptr->type = btype;
@@ -1,4 +1,5 @@
 #include "gstex.h"
+#include "numath/nusimd.h"
 
 static unsigned int GS_TexInitFlag;
 unsigned int GS_TexAllocs;
@@ -6,12 +7,146 @@ static unsigned int GS_NumTextures;
 s32 TexStages[4];
 s32 iss3cmp;
 static struct _GS_TEXTURE* GS_TexList;
+static u32 GS_TexMax;       // Slots in GS_TexList, grows past 0x400 when needed.
+static u16* GS_TexGen;      // Generation per slot, bumped when a slot is released.
+static s32* GS_TexFree;     // Stack of free slots.
+static u32 GS_TexFreeCount;
+static u32* GS_TexHandle;   // NUID -> (generation << 16) | slot, 0 when unused.
+static u32 GS_TexHandleMax;
+static u32 GS_TexDupes;     // Live textures registered under a NUID that was already mapped.
 enum _GXTexWrapMode GS_TexWrapMode_t [4];
 enum _GXTexWrapMode GS_TexWrapMode_s [4];
 enum _GXTevStageID ShadowBodge = GX_TEVSTAGE0;
 enum _GXTevStageID maxstage_189 = GX_TEVSTAGE15 | GX_MAX_TEVSTAGE | 0; //GX_TEVSTAGE15 | GX_MAX_TEVSTAGE | FFFFFFE0h
 
-//NGC MATCH
+// Put every slot back on the free stack (lowest first) and forget all NUIDs.
+static void GS_TexResetSlots(void) {
+    u32 i;
+
+    for (i = 0; i < GS_TexMax; i++) {
+        GS_TexFree[i] = (GS_TexMax - 1) - i;
+    }
+    GS_TexFreeCount = GS_TexMax;
+    GS_TexDupes = 0;
+    memset(GS_TexHandle,0,GS_TexHandleMax * sizeof(u32));
+    return;
+}
+
+// Double the texture table, the new slots go on the free stack.
+static void GS_TexGrow(void) {
+    struct _GS_TEXTURE* list;
+    u16* gen;
+    s32* freeslots;
+    u32 max;
+    u32 i;
+
+    max = GS_TexMax * 2;
+    list = (struct _GS_TEXTURE *)malloc(max * sizeof(struct _GS_TEXTURE));
+    gen = (u16 *)malloc(max * sizeof(u16));
+    freeslots = (s32 *)malloc(max * sizeof(s32));
+    if ((list == NULL) || (gen == NULL) || (freeslots == NULL)) {
+        DisplayErrorAndLockup("C:/source/crashwoc/code/system/gc/gstex.c",0x60,"GS_TexGrow");
+    }
+    memcpy(list,GS_TexList,GS_TexMax * sizeof(struct _GS_TEXTURE));
+    memset(list + GS_TexMax,0,(max - GS_TexMax) * sizeof(struct _GS_TEXTURE));
+    memcpy(gen,GS_TexGen,GS_TexMax * sizeof(u16));
+    memset(gen + GS_TexMax,0,(max - GS_TexMax) * sizeof(u16));
+    memcpy(freeslots,GS_TexFree,GS_TexFreeCount * sizeof(s32));
+    for (i = max; i > GS_TexMax; i--) {
+        freeslots[GS_TexFreeCount++] = i - 1;
+    }
+    free(GS_TexList);
+    free(GS_TexGen);
+    free(GS_TexFree);
+    GS_TexList = list;
+    GS_TexGen = gen;
+    GS_TexFree = freeslots;
+    GS_TexMax = max;
+    return;
+}
+
+// Texture for a NUID, NULL if there isn't a live one.
+static struct _GS_TEXTURE* GS_TexFind(u32 NUID) {
+    u32 h;
+
+    if (NUID >= GS_TexHandleMax) {
+        return NULL;
+    }
+    h = GS_TexHandle[NUID];
+    if ((h == 0) || (GS_TexGen[h & 0xffff] != (h >> 16)) || (GS_TexList[h & 0xffff].Flags == 0)) {
+        return NULL;
+    }
+    return &GS_TexList[h & 0xffff];
+}
+
+// Take a free slot and map NUID to it. An earlier live texture with the same NUID keeps the mapping, this one takes
+// over when GS_TexRelease frees it.
+static struct _GS_TEXTURE* GS_TexAllocSlot(u32 NUID) {
+    u32* handles;
+    u32 max;
+    s32 slot;
+
+    if (GS_TexFreeCount == 0) {
+        GS_TexGrow();
+    }
+    slot = GS_TexFree[--GS_TexFreeCount];
+    if (NUID >= GS_TexHandleMax) {
+        for (max = GS_TexHandleMax * 2; max <= NUID; max *= 2) {}
+        handles = (u32 *)malloc(max * sizeof(u32));
+        if (handles == NULL) {
+            DisplayErrorAndLockup("C:/source/crashwoc/code/system/gc/gstex.c",0x90,"GS_TexAllocSlot");
+        }
+        memcpy(handles,GS_TexHandle,GS_TexHandleMax * sizeof(u32));
+        memset(handles + GS_TexHandleMax,0,(max - GS_TexHandleMax) * sizeof(u32));
+        free(GS_TexHandle);
+        GS_TexHandle = handles;
+        GS_TexHandleMax = max;
+    }
+    if (GS_TexFind(NUID) == NULL) {
+        // Generation 0 is never handed out so a zero handle always means unused.
+        if (GS_TexGen[slot] == 0) {
+            GS_TexGen[slot] = 1;
+        }
+        GS_TexHandle[NUID] = ((u32)GS_TexGen[slot] << 16) | slot;
+    }
+    else {
+        GS_TexDupes++;
+    }
+    return &GS_TexList[slot];
+}
+
+// Free a single texture so its slot can be reused, e.g. when a level's textures are unloaded.
+void GS_TexRelease(s32 NUID) {
+    struct _GS_TEXTURE* pTex;
+    s32 slot;
+
+    pTex = GS_TexFind(NUID);
+    if (pTex == NULL) {
+        return;
+    }
+    slot = pTex - GS_TexList;
+    free((void *)pTex->TexBits);
+    memset(pTex,0,sizeof(struct _GS_TEXTURE));
+    GS_TexGen[slot]++;
+    GS_TexHandle[NUID] = 0;
+    GS_TexFree[GS_TexFreeCount++] = slot;
+    GS_NumTextures--;
+    // a later texture registered under the same NUID becomes the one it finds
+    if (GS_TexDupes != 0) {
+        for (slot = 0; slot < GS_TexMax; slot++) {
+            if ((GS_TexList[slot].Flags != 0) && (GS_TexList[slot].NUID == (u32)NUID)) {
+                if (GS_TexGen[slot] == 0) {
+                    GS_TexGen[slot] = 1;
+                }
+                GS_TexHandle[NUID] = ((u32)GS_TexGen[slot] << 16) | slot;
+                GS_TexDupes--;
+                break;
+            }
+        }
+    }
+    return;
+}
+
 void GS_TexInit(void) {
     s32 i;
 
@@ -22,6 +157,13 @@ void GS_TexInit(void) {
         }
         GS_TexList = (struct _GS_TEXTURE *)malloc(0x13000);
         memset(GS_TexList,0,0x13000);
+        GS_TexMax = 0x400;
+        GS_TexGen = (u16 *)malloc(GS_TexMax * sizeof(u16));
+        memset(GS_TexGen,0,GS_TexMax * sizeof(u16));
+        GS_TexFree = (s32 *)malloc(GS_TexMax * sizeof(s32));
+        GS_TexHandleMax = 0x400;
+        GS_TexHandle = (u32 *)malloc(GS_TexHandleMax * sizeof(u32));
+        GS_TexResetSlots();
         GS_NumTextures = 0;
         GS_TexInitFlag = 1;
     }
@@ -29,7 +171,6 @@ void GS_TexInit(void) {
 }
 
 
-// Re-initialize textures.	//NGC MATCH
 void GS_TexReInit(void) {
     s32 i;
     struct _GS_TEXTURE *GSTex;
@@ -42,14 +183,18 @@ void GS_TexReInit(void) {
            GS_TexWrapMode_s[i] = GS_TexWrapMode_t[i] = 1;
         }
 
-        for (i = 0; i < 0x400; i++) {
+        for (i = 0; i < GS_TexMax; i++) {
             if (GSTex->Flags == -1) {
                 free((void *)GSTex->TexBits);
             }
             GSTex = GSTex + 1;
         }
     }
-    memset(GS_TexList,0,0x13000);
+    memset(GS_TexList,0,GS_TexMax * sizeof(struct _GS_TEXTURE));
+    for (i = 0; i < GS_TexMax; i++) {
+        GS_TexGen[i]++;
+    }
+    GS_TexResetSlots();
     GS_NumTextures = 0;
     GS_TexAllocs = 0;
     return;
@@ -77,18 +222,19 @@ void GS_TexReInit(void) {
         }
     }
 */
-//MATCH GCN
 void GS_TexSwizzleRGB5A3(s32 nWidth,s32 nHeight,s32 *TxtBuf,char *DstBuf) {
     s32 w;
     s32 fixedH;
     s32 h;
     s32 iVar4;
     s32 iVar7;
-    u32 uVar8;
-    u32 uVar9;
     s32 iVar10;
     s32 iVar11;
     s32 iVar12;
+    nui4 texel;
+    nui4 opaque;
+    nui4 translucent;
+    u32 out[4];
 
     s32 fixedW = nWidth;
     if (fixedW < 0) {
@@ -102,22 +248,20 @@ void GS_TexSwizzleRGB5A3(s32 nWidth,s32 nHeight,s32 *TxtBuf,char *DstBuf) {
     }
     h = fixedH >> 2;
 
+    // Each 4x4 tile row is four neighbouring texels, so convert them a row at a time.
     iVar4 = 0;
     for (iVar11 = 0; iVar11 < h; iVar11++) {
         for(iVar10 = 0; iVar10 < w; iVar10++) {
             for(iVar7 = 0; iVar7 < 4; iVar7++) {
+                texel = NuI4LoadU(&TxtBuf[(iVar10*4) + (iVar11 * 4 + iVar7) * nWidth]);
+                opaque = NuI4Or(NuI4Or(NuI4Set1(0x8000), NuI4And(NuI4Srl(texel, 19), NuI4Set1(0x1f))),
+                                NuI4Or(NuI4And(NuI4Srl(texel, 6), NuI4Set1(0x3e0)), NuI4Sll(NuI4And(texel, NuI4Set1(0xf8)), 7)));
+                translucent = NuI4Or(NuI4Or(NuI4And(NuI4Srl(texel, 20), NuI4Set1(0xf)), NuI4And(NuI4Srl(texel, 8), NuI4Set1(0xf0))),
+                                     NuI4Or(NuI4Sll(NuI4And(texel, NuI4Set1(0xf0)), 4), NuI4And(NuI4Srl(texel, 17), NuI4Set1(0x7000))));
+                NuI4StoreU(out, NuI4Select(NuI4CmpEq(NuI4Srl(texel, 29), NuI4Set1(7)), opaque, translucent));
                 for(iVar12 = 0; iVar12 < 4; iVar12++) {
-                    uVar9 = TxtBuf[(iVar10*4) + (iVar11 * 4 + iVar7) * nWidth + iVar12];
-                    if ((uVar9 >> 29) == 7) {
-                        uVar8 = 0x8000 | ((uVar9 >> 19) & 0x1f) | ((uVar9 >> 6) & 0x3e0) |
-                                ((uVar9 & 0xf8) << 7);
-                    }
-                    else {
-                        uVar8 = (uVar9 >> 20) & 0xF | (uVar9 >> 8) & 0xf0 |
-                                ((uVar9 & 0xf0) << 4) | (uVar9 >> 17) & 0x7000;
-                    }
-                    DstBuf[iVar4++] = uVar8 >> 8;
-                    DstBuf[iVar4++] = uVar8;
+                    DstBuf[iVar4++] = out[iVar12] >> 8;
+                    DstBuf[iVar4++] = out[iVar12];
                 }
             }
         }
@@ -125,49 +269,38 @@ void GS_TexSwizzleRGB5A3(s32 nWidth,s32 nHeight,s32 *TxtBuf,char *DstBuf) {
     return;
 }
 
-//NGC MATCH
 void GS_TexCreateNU(enum nutextype_e Format,u32 width,u32 height,u8 *bits,u32 MipLevels,u32 RTFlag, s32 theirid) {
     char *newbits;
-    s32 i;
     struct _GS_TEXTURE* pTex;
 
-    pTex = GS_TexList;
     if (iss3cmp != 0) {
         newbits = (char *)malloc(iss3cmp);
         GS_TexAllocs = GS_TexAllocs + iss3cmp;
         memcpy(newbits,(char *)(bits + 0xc),iss3cmp);
         DCFlushRange(newbits,iss3cmp);
-        for (i = 0; i < 0x400; i++, pTex++) {
-            if (pTex->Flags != 0) {
-                pTex->Flags = -1;
-                pTex->Pad = 0xe;
-                pTex->Format = Format;
-                pTex->NUID = theirid;
-                pTex->Width = width;
-                pTex->Height = height;
-                pTex->TexBits = (u32)newbits;
-                GXInitTexObj(&pTex->Tex,newbits,width,height,0xE,0,0,'\0');
-                break;
-            }
-        }
+        pTex = GS_TexAllocSlot(theirid);
+        pTex->Flags = -1;
+        pTex->Pad = 0xe;
+        pTex->Format = Format;
+        pTex->NUID = theirid;
+        pTex->Width = width;
+        pTex->Height = height;
+        pTex->TexBits = (u32)newbits;
+        GXInitTexObj(&pTex->Tex,newbits,width,height,0xE,0,0,'\0');
     } else if (Format == 0x80) {
         newbits = (char *)malloc(MipLevels);
         GS_TexAllocs = GS_TexAllocs + MipLevels;
         memcpy(newbits,bits,MipLevels);
         DCFlushRange(newbits,MipLevels);
-        for (i = 0; i < 0x400; i++, pTex++) {
-            if (pTex->Flags == 0) {
-                pTex->Flags = -1;
-                pTex->Pad = 0xe;
-                pTex->Format = Format;
-                pTex->NUID = theirid;
-                pTex->Width = width;
-                pTex->Height = height;
-                pTex->TexBits = (u32)newbits;
-                GXInitTexObj(&pTex->Tex,newbits,width,height,0xE,0,0,'\0');
-                break;
-            }
-        }
+        pTex = GS_TexAllocSlot(theirid);
+        pTex->Flags = -1;
+        pTex->Pad = 0xe;
+        pTex->Format = Format;
+        pTex->NUID = theirid;
+        pTex->Width = width;
+        pTex->Height = height;
+        pTex->TexBits = (u32)newbits;
+        GXInitTexObj(&pTex->Tex,newbits,width,height,0xE,0,0,'\0');
     } else if (Format == 0x81) {
         s32 size = width * height * 2;
         newbits = (char *)malloc(size);
@@ -175,19 +308,15 @@ void GS_TexCreateNU(enum nutextype_e Format,u32 width,u32 height,u8 *bits,u32 Mi
         DCFlushRange(bits,size);
         memcpy(newbits,bits,size);
         DCFlushRange(newbits,size);
-        for (i = 0; i < 0x400; i++, pTex++) {
-            if (pTex->Flags == 0) {
-                pTex->Flags = -1;
-                pTex->Pad = 5;
-                pTex->Format = Format;
-                pTex->NUID = theirid;
-                pTex->Width = width;
-                pTex->Height = height;
-                pTex->TexBits = (u32)newbits;
-                GXInitTexObj(&pTex->Tex,newbits,width,height,5,0,0,'\0');
-                break;
-            }
-        }
+        pTex = GS_TexAllocSlot(theirid);
+        pTex->Flags = -1;
+        pTex->Pad = 5;
+        pTex->Format = Format;
+        pTex->NUID = theirid;
+        pTex->Width = width;
+        pTex->Height = height;
+        pTex->TexBits = (u32)newbits;
+        GXInitTexObj(&pTex->Tex,newbits,width,height,5,0,0,'\0');
     } else if (Format == 0x82) {
         s32 size = width * height * 4;
         newbits = (char *)malloc(size);
@@ -195,19 +324,15 @@ void GS_TexCreateNU(enum nutextype_e Format,u32 width,u32 height,u8 *bits,u32 Mi
         DCFlushRange(bits,size);
         memcpy(newbits,bits,size);
         DCFlushRange(newbits, size);
-        for (i = 0; i < 0x400; i++, pTex++) {
-            if (pTex->Flags == 0) {
-                pTex->Flags = -1;
-                pTex->Pad = 6;
-                pTex->Format = Format;
-                pTex->NUID = theirid;
-                pTex->Width = width;
-                pTex->Height = height;
-                pTex->TexBits = (u32)newbits;
-                GXInitTexObj(&pTex->Tex, newbits, width, height, 6, 0, 0, '\0');
-                break;
-            }
-        }
+        pTex = GS_TexAllocSlot(theirid);
+        pTex->Flags = -1;
+        pTex->Pad = 6;
+        pTex->Format = Format;
+        pTex->NUID = theirid;
+        pTex->Width = width;
+        pTex->Height = height;
+        pTex->TexBits = (u32)newbits;
+        GXInitTexObj(&pTex->Tex, newbits, width, height, 6, 0, 0, '\0');
     } else {
         s32 size = width * height * 2;
         newbits = (char *)malloc(size);
@@ -215,19 +340,15 @@ void GS_TexCreateNU(enum nutextype_e Format,u32 width,u32 height,u8 *bits,u32 Mi
         DCFlushRange(bits,width * height * 4);
         GS_TexSwizzleRGB5A3(width,height,(s32 *)bits,newbits);
         DCFlushRange(newbits,size);
-        for (i = 0; i < 0x400; i++, pTex++) {
-            if (pTex->Flags == 0) {
-                pTex->Flags = -1;
-                pTex->Pad = 5;
-                pTex->Format = Format;
-                pTex->Width = width;
-                pTex->NUID = theirid;
-                pTex->Height = height;
-                pTex->TexBits = (u32)newbits;
-                GXInitTexObj(&pTex->Tex,newbits,width,height,5,0, 0,'\0');
-                break;
-            }
-        }
+        pTex = GS_TexAllocSlot(theirid);
+        pTex->Flags = -1;
+        pTex->Pad = 5;
+        pTex->Format = Format;
+        pTex->Width = width;
+        pTex->NUID = theirid;
+        pTex->Height = height;
+        pTex->TexBits = (u32)newbits;
+        GXInitTexObj(&pTex->Tex,newbits,width,height,5,0, 0,'\0');
     }
     GS_NumTextures++;
     return;
@@ -350,22 +471,16 @@ switchD_800fa714_caseD_7:
    */
 }
 
-//MATCH NGC
 void GS_ChangeTextureStates(int id) {
-  u32 i;
   s32 st;
   struct _GS_TEXTURE *texlist;
   
   st = TexStages[id];
   st--;
-  texlist = GS_TexList;
-  for(i = 0; i < GS_NumTextures; i++) {
-      if (texlist->NUID == st) {
-        GXInitTexObjWrapMode(&texlist->Tex,GS_TexWrapMode_s[id],GS_TexWrapMode_t[id]);
-        GXLoadTexObj(&texlist->Tex,id);
-        return;
-      }
-      texlist++;
+  texlist = GS_TexFind(st);
+  if (texlist != NULL) {
+      GXInitTexObjWrapMode(&texlist->Tex,GS_TexWrapMode_s[id],GS_TexWrapMode_t[id]);
+      GXLoadTexObj(&texlist->Tex,id);
   }
   return;
 }
@@ -389,10 +504,21 @@ void GS_TexSetWrapModet(int id,enum _GXTexWrapMode mode) {
   return;
 }
 
-//NGC MATCH
+// Convert new RGBA32 texels into a texture GS_TexCreateNU swizzled to RGB5A3, same size as it was created with.
+void GS_TexUpdateNU(s32 NUID,u8 *bits) {
+    struct _GS_TEXTURE* pTex;
+
+    pTex = GS_TexFind(NUID);
+    if ((pTex == NULL) || (pTex->Pad != 5) || (pTex->Format == 0x81)) {
+        return;
+    }
+    GS_TexSwizzleRGB5A3(pTex->Width,pTex->Height,(s32 *)bits,(char *)pTex->TexBits);
+    DCFlushRange((void *)pTex->TexBits,pTex->Width * pTex->Height * 2);
+    return;
+}
+
 void GS_TexSelect(enum _GXTevStageID stage,s32 NUID) {
   s32 iVar1;
-  s32 i;
   struct _GS_TEXTURE *pTex;
 
   if (stage == GX_TEVSTAGE0) {
@@ -411,7 +537,6 @@ void GS_TexSelect(enum _GXTevStageID stage,s32 NUID) {
     if (NUID == ShadowMatBodge) {
       ShadowBodge = 1;
     }
-    pTex = GS_TexList;
     if ((s32)stage > (s32)maxstage_189) {
       maxstage_189 = stage;
     }
@@ -439,14 +564,13 @@ void GS_TexSelect(enum _GXTevStageID stage,s32 NUID) {
     GXSetTevAlphaOp(stage,0,0,0,1,0);
     if (NUID - 0x270eU > 1) {
     NUID--;
-    for(i = 0; i < GS_NumTextures; i++, pTex++) {
-          if (pTex->NUID == NUID) {
-            GXInitTexObjWrapMode(&pTex->Tex,GS_TexWrapMode_s[stage],GS_TexWrapMode_t[stage]);
-            GXLoadTexObj(&pTex->Tex,stage);
-            return;
-          }
-    }
-      
+      pTex = GS_TexFind(NUID);
+      if (pTex != NULL) {
+          GXInitTexObjWrapMode(&pTex->Tex,GS_TexWrapMode_s[stage],GS_TexWrapMode_t[stage]);
+          GXLoadTexObj(&pTex->Tex,stage);
+          return;
+      }
+
       DisplayErrorAndLockup("C:/source/crashwoc/code/system/gc/gstex.c",0x281,"GS_TexSelect2");
       GXLoadTexObj(&GS_TexList->Tex,stage);
     }
@@ -20,4 +20,9 @@
   800cc0f0 000004 800cc0f0  4 GS_SetTextureStageState 	Global
 */
 
+void GS_TexRelease(s32 NUID);
+
+// Refill an RGB5A3 texture from RGBA32 texels of the size it was created with.
+void GS_TexUpdateNU(s32 NUID,u8 *bits);
+
 #endif